@@ -0,0 +1,72 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: arena.c has implemented functions for the arena allocator.
+*		   arena_init() Setting up an empty arena.
+*		   arena_alloc() Handing out memory from the current chunk (New chunk when it's full).
+*		   arena_fprintf_usage() Writing how many bytes and chunks the arena used.
+*		   arena_free() Freeing every chunk in one call.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "arena.h"
+
+//Function to set up an empty arena.
+void arena_init(Arena *arena) {
+	arena->current         = NULL;
+	arena->next_chunk_size = ARENA_CHUNK_SIZE;
+	arena->bytes_used      = 0;
+	arena->bytes_reserved  = 0;
+	arena->chunk_count     = 0;
+}
+
+//Function to get size bytes from the arena.
+char *arena_alloc(Arena *arena, size_t size) {
+
+	//Allocating a new chunk if the current one doesn't have enough room left.
+	if (arena->current == NULL || arena->current->size - arena->current->used < size) {
+
+		//Chunks double up to ARENA_MAX_CHUNK_SIZE. A request bigger than that gets a chunk of its own size.
+		size_t chunk_size = arena->next_chunk_size > size ? arena->next_chunk_size : size;
+		ArenaChunk *chunk = malloc(sizeof(ArenaChunk) + chunk_size);
+
+		//Throwing an error, if memory allocation failed.
+		if (chunk == NULL) {
+			puts("Memory allocation for arena chunk failed :(\n");
+			exit(1);
+		}
+
+		chunk->next = arena->current;
+		chunk->size = chunk_size;
+		chunk->used = 0;
+		arena->current = chunk;
+		arena->bytes_reserved += chunk_size;
+		arena->chunk_count++;
+
+		if (arena->next_chunk_size < ARENA_MAX_CHUNK_SIZE) {
+			arena->next_chunk_size *= 2;
+		}
+	}
+
+	char *memory = arena->current->data + arena->current->used;
+	arena->current->used += size;
+	arena->bytes_used    += size;
+	return memory;
+}
+
+//Function to write how many bytes and chunks the arena used.
+void arena_fprintf_usage(FILE *file, const Arena *arena) {
+	fprintf(file, "Arena: %zu bytes used, %zu bytes reserved in %d chunks\n", arena->bytes_used,
+		arena->bytes_reserved, arena->chunk_count);
+}
+
+//Function to free every chunk of the arena in one call.
+void arena_free(Arena *arena) {
+	while (arena->current != NULL) {
+		ArenaChunk *next = arena->current->next;
+		free(arena->current);
+		arena->current = next;
+	}
+	arena_init(arena);
+}
@@ -0,0 +1,43 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: Has the arena (bump) allocator used for student names and its function prototypes.
+*          Memory is handed out from big chunks and everything is freed in one call.
+*/
+#ifndef ARENA_H //Checking if ARENA_H is not defined
+#define ARENA_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#define ARENA_CHUNK_SIZE (64 * 1024) //Size of the first chunk in bytes.
+#define ARENA_MAX_CHUNK_SIZE (16 * 1024 * 1024) //Chunks stop doubling at this size.
+
+typedef struct ArenaChunk {     //One chunk of arena memory
+    struct ArenaChunk *next;    //Previously filled chunk
+    size_t size;                //Bytes this chunk can hold
+    size_t used;                //Bytes handed out from this chunk
+    char data[];                //Memory handed out
+} ArenaChunk;
+
+typedef struct {                //Arena allocator
+    ArenaChunk *current;        //Chunk memory is handed out from
+    size_t next_chunk_size;     //Size of the next chunk to allocate
+    size_t bytes_used;          //Bytes handed out (Counter)
+    size_t bytes_reserved;      //Bytes allocated for chunks (Counter)
+    int chunk_count;            //Number of chunks allocated (Counter)
+} Arena;
+
+//Function to set up an empty arena (No memory is allocated until the first arena_alloc())
+void arena_init(Arena *arena);
+
+//Function to get size bytes from the arena (Allocates a new chunk when the current one is full)
+char *arena_alloc(Arena *arena, size_t size);
+
+//Function to write how many bytes and chunks the arena used
+void arena_fprintf_usage(FILE *file, const Arena *arena);
+
+//Function to free every chunk of the arena in one call
+void arena_free(Arena *arena);
+
+#endif // Ending #ifndef block
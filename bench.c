@@ -0,0 +1,609 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: Benchmark for the option 4 sort engines.
+*          Compares selection sort, merge sort and radix sort at 10k, 1M and 10M records (or counts given as arguments).
+*          Selection sort is only timed up to SELECTION_SORT_LIMIT records, bigger counts are extrapolated (O(n^2)).
+*          Also times parse_line_of_file() and shows the bytes and chunks used by the names arena.
+*          Also times strtof()/atoi() against the fixed-point parse_gpa()/parse_toefl().
+*          Also shows records per second of each filter kernel (scalar, SSE2, AVX2) the CPU can run.
+*          Also times the option 4 sort on 1, 2, 4, ... threads and checks every thread count gives the same order.
+*          Also times option 4 (Sort, then write) on the void ** records against the columnar table, where every
+*          column has one type, so neither the sort nor the writer reads domestic_char to know what a record is.
+*
+*          With options instead of counts, times each stage of a Lab6 run on a generated roster and writes JSON:
+*          Lab6_bench [--records N] [--international rate] [--gpa uniform|normal] [--gpa-mean gpa]
+*                     [--gpa-stddev gpa] [--malformed rate] [--seed seed] [--roster file]
+*          Stages are generate, parse (lines into fields and numbers), validate (checks and loading the table),
+*          filter (options 1 ~ 3 in one scan), sort (option 4) and write (option 4 into a temporary file).
+*          --roster also saves the generated roster, so it can be given to Lab6.
+*/
+
+#define _POSIX_C_SOURCE 200809L //For clock_gettime() and fileno()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "student.h"
+#include "input.h"
+#include "table.h"
+#include "scan.h"
+#include "query.h"
+#include "writer.h"
+#include "generator.h"
+#include "psort.h"
+
+#define SELECTION_SORT_LIMIT 20000 //Largest record count selection sort is actually run on.
+#define NUMBER_FIELD_SIZE 16 //Bytes per generated gpa or TOEFL field.
+
+//Function to get current time in seconds.
+static double now_seconds(void) {
+	struct timespec time_now;
+	clock_gettime(CLOCK_MONOTONIC, &time_now);
+	return time_now.tv_sec + time_now.tv_nsec / 1e9;
+}
+
+//Function to make a random gpa with three decimal places (0.000 ~ 4.300).
+static float random_gpa(unsigned int *seed) {
+	*seed = *seed * 1103515245u + 12345u;
+	return (float)((*seed >> 8) % 4301) / 1000.0f;
+}
+
+//Function to fill up random students. Roughly half domestic, half international.
+static void make_students(int count, Domestic *domestic, International *international, void **all_students,
+	int *domestic_count, int *international_count) {
+	static char name[] = "Bench Student";
+	unsigned int seed = 2510;
+
+	*domestic_count      = 0;
+	*international_count = 0;
+
+	for (int i = 0; i < count; i++) {
+		float gpa = random_gpa(&seed);
+
+		if ((seed >> 4) & 1) {
+			domestic[*domestic_count] = (Domestic){name, gpa, 'D'};
+			(*domestic_count)++;
+		} else {
+			international[*international_count] = (International){name, gpa, 'I', 70 + (int)(seed % 50)};
+			(*international_count)++;
+		}
+	}
+
+	//Same layout as fprintf_sorted_gpa() (Domestic first, then international).
+	for (int i = 0; i < *domestic_count; i++) {
+		all_students[i] = &domestic[i];
+	}
+	for (int i = 0; i < *international_count; i++) {
+		all_students[*domestic_count + i] = &international[i];
+	}
+}
+
+//Function to time one sort over a fresh copy of the students.
+static double time_sort(void (*sort)(void **, int), void **all_students, void **work, int count) {
+	memcpy(work, all_students, count * sizeof(void*));
+	double start = now_seconds();
+	sort(work, count);
+	return now_seconds() - start;
+}
+
+//Wrapper so radix sort has the same shape as the other sorts.
+static void radix_sort_or_merge_sort(void **students, int count) {
+	if (!radix_sort_students_gpa(students, count)) {
+		merge_sort_students_gpa(students, count);
+	}
+}
+
+//Function to time parsing count lines with parse_line_of_file() and show how much of the names arena it used.
+static void time_parse_with_arena(int count) {
+	Domestic domestic;
+	International international;
+	Arena names;
+	char line[MAX_LINE_LENGTH];
+	unsigned int seed = 2510;
+
+	arena_init(&names);
+	double start = now_seconds();
+
+	for (int i = 0; i < count; i++) {
+		float gpa = random_gpa(&seed);
+
+		if ((seed >> 4) & 1) {
+			snprintf(line, sizeof(line), "Bench Student%d %.3f D\n", i, gpa);
+		} else {
+			snprintf(line, sizeof(line), "Bench Student%d %.3f I %d\n", i, gpa, 70 + (int)(seed % 50));
+		}
+		parse_line_of_file(line, &domestic, &international, &names);
+	}
+
+	printf("%12d %16.4f   ", count, now_seconds() - start);
+	arena_fprintf_usage(stdout, &names);
+	arena_free(&names);
+}
+
+//Function to time strtof()/atoi() against parse_gpa()/parse_toefl() on count gpa and TOEFL fields.
+static void time_number_parsing(int count) {
+	char *gpa_fields   = malloc(count * NUMBER_FIELD_SIZE);
+	char *toefl_fields = malloc(count * NUMBER_FIELD_SIZE);
+	unsigned int seed  = 2510;
+
+	//Throwing an error, if memory allocation failed.
+	if (gpa_fields == NULL || toefl_fields == NULL) {
+		puts("Memory allocation for benchmark failed :(\n");
+		exit(1);
+	}
+
+	for (int i = 0; i < count; i++) {
+		snprintf(gpa_fields + i * NUMBER_FIELD_SIZE, NUMBER_FIELD_SIZE, "%.3f", random_gpa(&seed));
+		snprintf(toefl_fields + i * NUMBER_FIELD_SIZE, NUMBER_FIELD_SIZE, "%d", (int)(seed % 120) + 1);
+	}
+
+	//Sums are printed, so the compiler can't drop the parsing.
+	double float_sum = 0.0;
+	long long int_sum = 0;
+	double start = now_seconds();
+	for (int i = 0; i < count; i++) {
+		float_sum += strtof(gpa_fields + i * NUMBER_FIELD_SIZE, NULL);
+		int_sum   += atoi(toefl_fields + i * NUMBER_FIELD_SIZE);
+	}
+	double library_seconds = now_seconds() - start;
+
+	long long fixed_point_sum = 0;
+	start = now_seconds();
+	for (int i = 0; i < count; i++) {
+		const char *gpa_field   = gpa_fields + i * NUMBER_FIELD_SIZE;
+		const char *toefl_field = toefl_fields + i * NUMBER_FIELD_SIZE;
+		int gpa   = 0;
+		int toefl = 0;
+
+		parse_gpa((Slice){gpa_field, strlen(gpa_field)}, &gpa);
+		parse_toefl((Slice){toefl_field, strlen(toefl_field)}, &toefl);
+		fixed_point_sum += gpa;
+		int_sum         += toefl;
+	}
+	double fixed_seconds = now_seconds() - start;
+
+	printf("%12d %16.4f %16.4f   (checksums %.0f %lld %lld)\n", count, library_seconds, fixed_seconds, float_sum,
+		fixed_point_sum, int_sum);
+	free(gpa_fields);
+	free(toefl_fields);
+}
+
+//Function to fill up a table with count random students. Roughly half domestic, half international.
+static void make_table(StudentTable *table, int count) {
+	unsigned int seed = 2510;
+	Slice first_name  = {"Bench", 5};
+	Slice last_name   = {"Student", 7};
+
+	table_init(table, count);
+	for (int i = 0; i < count; i++) {
+		int gpa = gpa_from_thousandths((int)(random_gpa(&seed) * 1000.0f + 0.5f));
+
+		if ((seed >> 4) & 1) {
+			table_append(table, first_name, last_name, gpa, 'D', 0);
+		} else {
+			table_append(table, first_name, last_name, gpa, 'I', 40 + (int)(seed % 80));
+		}
+	}
+}
+
+//Function to time every filter kernel this CPU can run on a table of count students, in records per second.
+static void time_scan_kernels(int count) {
+	StudentTable table;
+	make_table(&table, count);
+
+	//Option 3 filter: GPA > 3.9, and TOEFL >= 70 for international students.
+	ScanFilter filter     = {gpa_from_thousandths(3900) + 1, 0x7FFFFFFF, 70, 0x7FFFFFFF, 1, 1};
+	unsigned int *indices = malloc(count * sizeof(unsigned int));
+
+	//Throwing an error, if memory allocation failed.
+	if (indices == NULL) {
+		puts("Memory allocation for benchmark failed :(\n");
+		exit(1);
+	}
+
+	for (int kernel = SCAN_KERNEL_SCALAR; kernel <= scan_best_kernel(); kernel++) {
+		double start        = now_seconds();
+		int num_of_selected = scan_select_kernel(kernel, &table, &filter, 0, count, indices);
+		double seconds      = now_seconds() - start;
+
+		printf("%12d %8s %16.4f %16.0f %10d\n", count, scan_kernel_name(kernel), seconds,
+			seconds > 0.0 ? count / seconds : 0.0, num_of_selected);
+	}
+	free(indices);
+	table_free(&table);
+}
+
+//Function to write one stage of the pipeline as JSON.
+static void print_stage(const char *name, double seconds, long records, int last) {
+	printf("    {\"name\": \"%s\", \"seconds\": %.6f, \"records_per_second\": %.0f}%s\n", name, seconds,
+		seconds > 0.0 ? records / seconds : 0.0, last ? "" : ",");
+}
+
+//Function to time each stage of a Lab6 run on a generated roster and write the results as JSON.
+static void run_pipeline(const RosterConfig *config, const char *roster_file_name) {
+	double start = now_seconds();
+	size_t roster_size;
+	char *roster = generate_roster(config, &roster_size);
+	double generate_seconds = now_seconds() - start;
+
+	//Going through a file, so parsing reads a memory-mapped input like Lab6 does.
+	FILE *roster_file = roster_file_name != NULL ? fopen(roster_file_name, "w+") : tmpfile();
+	if (roster_file == NULL || fwrite(roster, 1, roster_size, roster_file) != roster_size || fflush(roster_file) != 0) {
+		puts("Writing the roster failed :(\n");
+		exit(1);
+	}
+	free(roster);
+
+	ParsedStudent *students = malloc(config->records * sizeof(ParsedStudent));
+	int *results            = malloc(config->records * sizeof(int));
+
+	//Throwing an error, if memory allocation failed.
+	if (students == NULL || results == NULL) {
+		puts("Memory allocation for benchmark failed :(\n");
+		exit(1);
+	}
+
+	//Parse: lines into fields and numbers.
+	InputReader reader;
+	Slice file_line;
+	long num_of_lines = 0;
+	input_open(&reader, roster_file);
+	start = now_seconds();
+	while (input_next_line(&reader, &file_line)) {
+		results[num_of_lines] = parse_student(file_line, &students[num_of_lines]);
+		num_of_lines++;
+	}
+	double parse_seconds = now_seconds() - start;
+
+	//Validate: counting each result and loading the valid students into the table.
+	StudentTable table;
+	long reasons[NUM_OF_PARSE_RESULTS] = {0};
+	table_init(&table, MAX_STUDENT);
+	start = now_seconds();
+	for (long i = 0; i < num_of_lines; i++) {
+		reasons[results[i]]++;
+		if (results[i] == PARSE_OK) {
+			table_append(&table, students[i].first_name, students[i].last_name, students[i].gpa, students[i].status,
+				students[i].toefl);
+		}
+	}
+	double validate_seconds = now_seconds() - start;
+	input_close(&reader);
+
+	//Filter: options 1 ~ 3 in one scan.
+	ScanFilter filters[3];
+	unsigned int *indices[3];
+	int counts[3];
+	for (int i = 0; i < 3; i++) {
+		Query query;
+		query_preset(i + 1, &query);
+		filters[i] = query.filter;
+		indices[i] = table_allocate_indices(&table);
+	}
+	start = now_seconds();
+	scan_select_many(&table, filters, 3, indices, counts);
+	double filter_seconds = now_seconds() - start;
+
+	//Sort: every student by gpa (Option 4).
+	unsigned int *order = table_allocate_indices(&table);
+	for (int i = 0; i < table.count; i++) {
+		order[i] = i;
+	}
+	start = now_seconds();
+	table_sort_indices_by_gpa(&table, order, table.count, 1);
+	double sort_seconds = now_seconds() - start;
+
+	//Write: option 4 into a temporary file.
+	FILE *output_file = tmpfile();
+	OutputWriter writer;
+	if (output_file == NULL) {
+		puts("Opening a temporary output file failed :(\n");
+		exit(1);
+	}
+	writer_open(&writer, output_file, WRITER_BUFFER_SIZE);
+	start = now_seconds();
+	for (int i = 0; i < table.count; i++) {
+		table_write_student(&writer, &table, order[i], 0);
+	}
+	writer_close(&writer);
+	double write_seconds = now_seconds() - start;
+	long output_bytes = lseek(fileno(output_file), 0, SEEK_CUR);
+
+	printf("{\n  \"config\": {\"records\": %ld, \"international_rate\": %g, \"gpa_distribution\": \"%s\", "
+		"\"gpa_mean\": %g, \"gpa_stddev\": %g, \"malformed_rate\": %g, \"seed\": %u},\n", config->records,
+		config->international_rate, config->gpa_distribution == GPA_NORMAL ? "normal" : "uniform", config->gpa_mean,
+		config->gpa_stddev, config->malformed_rate, config->seed);
+	printf("  \"kernel\": \"%s\",\n  \"input_bytes\": %zu,\n  \"output_bytes\": %ld,\n", scan_kernel_name(
+		scan_best_kernel()), roster_size, output_bytes);
+	printf("  \"lines\": %ld,\n  \"results\": {", num_of_lines);
+	for (int i = 0; i < NUM_OF_PARSE_RESULTS; i++) {
+		printf("\"%s\": %ld%s", parse_result_name(i), reasons[i], i < NUM_OF_PARSE_RESULTS - 1 ? ", " : "},\n");
+	}
+	printf("  \"selected\": {\"option1\": %d, \"option2\": %d, \"option3\": %d},\n", counts[0], counts[1],
+		counts[2]);
+	printf("  \"stages\": [\n");
+	print_stage("generate", generate_seconds, config->records, 0);
+	print_stage("parse", parse_seconds, num_of_lines, 0);
+	print_stage("validate", validate_seconds, num_of_lines, 0);
+	print_stage("filter", filter_seconds, table.count, 0);
+	print_stage("sort", sort_seconds, table.count, 0);
+	print_stage("write", write_seconds, table.count, 1);
+	printf("  ]\n}\n");
+
+	for (int i = 0; i < 3; i++) {
+		free(indices[i]);
+	}
+	free(order);
+	free(students);
+	free(results);
+	table_free(&table);
+	fclose(output_file);
+	fclose(roster_file);
+}
+
+//Function to read the pipeline options into config. Returns 0 if an option is wrong.
+static int read_pipeline_options(int argc, char *argv[], RosterConfig *config, const char **roster_file_name) {
+	generator_defaults(config);
+	*roster_file_name = NULL;
+
+	for (int i = 1; i < argc; i++) {
+		if (i + 1 >= argc) {
+			printf("Missing value for %s :p\n", argv[i]);
+			return 0;
+		}
+		const char *value = argv[++i];
+
+		if (strcmp(argv[i - 1], "--records") == 0) {
+			config->records = atol(value);
+		} else if (strcmp(argv[i - 1], "--international") == 0) {
+			config->international_rate = atof(value);
+		} else if (strcmp(argv[i - 1], "--gpa") == 0 && strcmp(value, "uniform") == 0) {
+			config->gpa_distribution = GPA_UNIFORM;
+		} else if (strcmp(argv[i - 1], "--gpa") == 0 && strcmp(value, "normal") == 0) {
+			config->gpa_distribution = GPA_NORMAL;
+		} else if (strcmp(argv[i - 1], "--gpa-mean") == 0) {
+			config->gpa_mean = atof(value);
+		} else if (strcmp(argv[i - 1], "--gpa-stddev") == 0) {
+			config->gpa_stddev = atof(value);
+		} else if (strcmp(argv[i - 1], "--malformed") == 0) {
+			config->malformed_rate = atof(value);
+		} else if (strcmp(argv[i - 1], "--seed") == 0) {
+			config->seed = (unsigned int)strtoul(value, NULL, 10);
+		} else if (strcmp(argv[i - 1], "--roster") == 0) {
+			*roster_file_name = value;
+		} else {
+			printf("Unknown argument: %s %s :p\n", argv[i - 1], value);
+			return 0;
+		}
+	}
+
+	//Throwing an error, if the record count isn't a positive number.
+	if (config->records <= 0 || config->records > 0x7FFFFFFF) {
+		puts("Number of records (--records) has to be between 1 and 2147483647 :p\n");
+		return 0;
+	}
+	return 1;
+}
+
+//Function to time the option 4 sort of count students on 1, 2, 4, ... threads (Up to the number of CPUs).
+//Every thread count has to give the same order as one thread.
+static void time_parallel_sort(int count) {
+	StudentTable table;
+	unsigned int *serial   = malloc(count * sizeof(unsigned int));
+	unsigned int *parallel = malloc(count * sizeof(unsigned int));
+	long num_of_cpus       = sysconf(_SC_NPROCESSORS_ONLN);
+
+	//Throwing an error, if memory allocation failed.
+	if (serial == NULL || parallel == NULL) {
+		puts("Memory allocation for benchmark failed :(\n");
+		exit(1);
+	}
+	make_table(&table, count);
+
+	double serial_seconds = 0.0;
+	for (int threads = 1; threads == 1 || threads <= num_of_cpus; threads *= 2) {
+		unsigned int *indices = threads == 1 ? serial : parallel;
+		for (int i = 0; i < count; i++) {
+			indices[i] = i;
+		}
+
+		double start = now_seconds();
+		parallel_sort_indices_by_gpa(&table, indices, count, 1, threads);
+		double seconds = now_seconds() - start;
+
+		if (threads == 1) {
+			serial_seconds = seconds;
+		}
+		printf("%12d %8d %16.4f %9.2fx %10s\n", count, threads, seconds, seconds > 0.0 ? serial_seconds / seconds : 0.0,
+			threads == 1 || memcmp(serial, parallel, count * sizeof(unsigned int)) == 0 ? "yes" : "NO");
+	}
+	free(serial);
+	free(parallel);
+	table_free(&table);
+}
+
+//Function to read a whole temporary file back, so two outputs can be compared.
+static char *read_back(FILE *file, long *size) {
+	fflush(file);
+	*size = ftell(file);
+	char *data = malloc(*size + 1);
+
+	//Throwing an error, if memory allocation failed.
+	if (data == NULL) {
+		puts("Memory allocation for benchmark failed :(\n");
+		exit(1);
+	}
+	rewind(file);
+	*size = (long)fread(data, 1, *size, file);
+	return data;
+}
+
+//Function to time option 4 on count students as void ** records (Domestic or International behind each pointer,
+//told apart by domestic_char) against the columnar table (gpa, status and TOEFL each in their own array).
+//Both write the same file, so the output is compared too.
+static void time_record_layouts(int count) {
+	Domestic *domestic           = malloc(count * sizeof(Domestic));
+	International *international = malloc(count * sizeof(International));
+	void **all_students          = malloc(count * sizeof(void*));
+	FILE *records_file           = tmpfile();
+	FILE *table_file             = tmpfile();
+	StudentTable table;
+
+	//Throwing an error, if memory allocation failed.
+	if (domestic == NULL || international == NULL || all_students == NULL) {
+		puts("Memory allocation for benchmark failed :(\n");
+		exit(1);
+	}
+
+	//Throwing an error, if temporary files can't be made.
+	if (records_file == NULL || table_file == NULL) {
+		puts("Making temporary files for benchmark failed :(\n");
+		exit(1);
+	}
+
+	int domestic_count;
+	int international_count;
+	make_students(count, domestic, international, all_students, &domestic_count, &international_count);
+	make_table(&table, count);
+
+	//Sort only: radix sort over void ** against radix sort over the gpa column.
+	double start = now_seconds();
+	radix_sort_or_merge_sort(all_students, count);
+	double records_sort_seconds = now_seconds() - start;
+
+	start = now_seconds();
+	table_build_gpa_order(&table);
+	double table_sort_seconds = now_seconds() - start;
+
+	//Whole option 4 (Sort, then write) like Lab6 runs it on each layout.
+	start = now_seconds();
+	fprintf_sorted_gpa(records_file, domestic, international, domestic_count, international_count);
+	fflush(records_file);
+	double records_seconds = now_seconds() - start;
+
+	OutputWriter writer;
+	start = now_seconds();
+	table_build_gpa_order(&table);
+	writer_open(&writer, table_file, WRITER_BUFFER_SIZE);
+	for (int i = 0; i < table.count; i++) {
+		table_write_student(&writer, &table, table.gpa_order[i], 0);
+	}
+	writer_close(&writer);
+	double table_seconds = now_seconds() - start;
+
+	long records_size;
+	long table_size;
+	char *records_output = read_back(records_file, &records_size);
+	char *table_output   = read_back(table_file, &table_size);
+
+	printf("%12d %16.4f %16.4f %16.4f %16.4f %9.2fx %6s\n", count, records_sort_seconds, table_sort_seconds,
+		records_seconds, table_seconds, table_seconds > 0.0 ? records_seconds / table_seconds : 0.0,
+		records_size == table_size && memcmp(records_output, table_output, records_size) == 0 ? "yes" : "NO");
+
+	free(records_output);
+	free(table_output);
+	fclose(records_file);
+	fclose(table_file);
+	table_free(&table);
+	free(domestic);
+	free(international);
+	free(all_students);
+}
+
+int main(int argc, char *argv[]) {
+	//Options instead of counts: timing each stage on a generated roster.
+	if (argc > 1 && strncmp(argv[1], "--", 2) == 0) {
+		RosterConfig config;
+		const char *roster_file_name;
+
+		if (!read_pipeline_options(argc, argv, &config, &roster_file_name)) {
+			return 1;
+		}
+		run_pipeline(&config, roster_file_name);
+		return 0;
+	}
+
+	int default_counts[] = {10000, 1000000, 10000000};
+	int num_of_counts    = argc > 1 ? argc - 1 : 3;
+	double selection_seconds_per_pair = 0.0; //Measured selection sort cost per n^2, for extrapolation.
+
+	printf("%12s %16s %16s %16s\n", "records", "selection (s)", "merge (s)", "radix (s)");
+
+	for (int c = 0; c < num_of_counts; c++) {
+		int count = argc > 1 ? atoi(argv[c + 1]) : default_counts[c];
+
+		if (count <= 0) {
+			printf("Invalid record count: %s\n", argv[c + 1]);
+			return 1;
+		}
+
+		Domestic *domestic           = malloc(count * sizeof(Domestic));
+		International *international = malloc(count * sizeof(International));
+		void **all_students          = malloc(count * sizeof(void*));
+		void **work                  = malloc(count * sizeof(void*));
+
+		//Throwing an error, if memory allocation failed.
+		if (domestic == NULL || international == NULL || all_students == NULL || work == NULL) {
+			puts("Memory allocation for benchmark failed :(\n");
+			return 1;
+		}
+
+		int domestic_count;
+		int international_count;
+		make_students(count, domestic, international, all_students, &domestic_count, &international_count);
+
+		double merge_seconds = time_sort(merge_sort_students_gpa, all_students, work, count);
+		double radix_seconds = time_sort(radix_sort_or_merge_sort, all_students, work, count);
+
+		if (count <= SELECTION_SORT_LIMIT) {
+			double selection_seconds = time_sort(sort_students_gpa, all_students, work, count);
+			selection_seconds_per_pair = selection_seconds / ((double)count * count);
+			printf("%12d %16.4f %16.4f %16.4f\n", count, selection_seconds, merge_seconds, radix_seconds);
+		} else {
+			//Measuring a 10k run first if no small count has been measured yet.
+			if (selection_seconds_per_pair == 0.0) {
+				int small_count = count < 10000 ? count : 10000;
+				selection_seconds_per_pair = time_sort(sort_students_gpa, all_students, work, small_count) /
+					((double)small_count * small_count);
+			}
+			printf("%12d %15.1f~ %16.4f %16.4f\n", count, selection_seconds_per_pair * count * count,
+				merge_seconds, radix_seconds);
+		}
+
+		free(domestic);
+		free(international);
+		free(all_students);
+		free(work);
+	}
+	puts("(~ = extrapolated from a measured run, selection sort is O(n^2))");
+
+	printf("\n%12s %16s   %s\n", "records", "parse (s)", "names arena");
+	for (int c = 0; c < num_of_counts; c++) {
+		time_parse_with_arena(argc > 1 ? atoi(argv[c + 1]) : default_counts[c]);
+	}
+
+	printf("\n%12s %16s %16s\n", "records", "strtof/atoi (s)", "fixed-point (s)");
+	for (int c = 0; c < num_of_counts; c++) {
+		time_number_parsing(argc > 1 ? atoi(argv[c + 1]) : default_counts[c]);
+	}
+
+	printf("\n%12s %8s %16s %16s %10s\n", "records", "kernel", "filter (s)", "records/s", "selected");
+	for (int c = 0; c < num_of_counts; c++) {
+		time_scan_kernels(argc > 1 ? atoi(argv[c + 1]) : default_counts[c]);
+	}
+
+	printf("\n%12s %8s %16s %10s %10s\n", "records", "threads", "sort (s)", "speedup", "same");
+	for (int c = 0; c < num_of_counts; c++) {
+		time_parallel_sort(argc > 1 ? atoi(argv[c + 1]) : default_counts[c]);
+	}
+
+	printf("\n%12s %16s %16s %16s %16s %10s %6s\n", "records", "void ** sort (s)", "table sort (s)",
+		"void ** opt4 (s)", "table opt4 (s)", "speedup", "same");
+	for (int c = 0; c < num_of_counts; c++) {
+		time_record_layouts(argc > 1 ? atoi(argv[c + 1]) : default_counts[c]);
+	}
+	return 0;
+}
@@ -0,0 +1,105 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: generator.c has implemented functions for the synthetic roster generator.
+*		   generator_defaults() Setting the default roster settings.
+*		   generate_roster() Making the text of a roster from the settings.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "generator.h"
+
+#define MAX_GENERATED_LINE 64 //Longest generated line in bytes (Names are short).
+#define RANDOM_RANGE 16777216.0 //Random numbers are 24 bits.
+
+//Function to get the next random number (24 bits) from the seed.
+static unsigned int next_random(unsigned int *seed) {
+	*seed = *seed * 1103515245u + 12345u;
+	return *seed >> 8;
+}
+
+//Function to get a random number in [0, 1).
+static double next_unit(unsigned int *seed) {
+	return next_random(seed) / RANDOM_RANGE;
+}
+
+//Function to make a gpa in thousandths from the distribution.
+static int next_gpa(const RosterConfig *config, unsigned int *seed) {
+	if (config->gpa_distribution == GPA_NORMAL) {
+
+		//Sum of 12 uniform numbers minus 6 is close to a standard normal number (No libm needed).
+		double normal = -6.0;
+		for (int i = 0; i < 12; i++) {
+			normal += next_unit(seed);
+		}
+
+		int gpa = (int)((config->gpa_mean + normal * config->gpa_stddev) * 1000.0 + 0.5);
+		return gpa < 1 ? 1 : gpa > GENERATOR_MAX_GPA ? GENERATOR_MAX_GPA : gpa;
+	}
+	return 1 + (int)(next_random(seed) % GENERATOR_MAX_GPA);
+}
+
+//Function to write one line into line. Returns its length.
+static int make_line(const RosterConfig *config, unsigned int *seed, long number, char *line) {
+	int gpa          = next_gpa(config, seed);
+	int is_domestic  = next_unit(seed) >= config->international_rate;
+	int toefl        = 40 + (int)(next_random(seed) % 81);
+	int whole        = gpa / 1000;
+	int thousandths  = gpa % 1000;
+
+	if (next_unit(seed) < config->malformed_rate) {
+		switch (next_random(seed) % 5) {
+			case 0:
+				return snprintf(line, MAX_GENERATED_LINE, "First%ld Last%ld\n", number, number);
+			case 1:
+				return snprintf(line, MAX_GENERATED_LINE, "First%ld Last%ld %d.%03d I 0\n", number, number, whole,
+					thousandths);
+			case 2:
+				return snprintf(line, MAX_GENERATED_LINE, "First%ld Last%ld %d.%03d I\n", number, number, whole,
+					thousandths);
+			case 3:
+				return snprintf(line, MAX_GENERATED_LINE, "First%ld Last%ld gpa D\n", number, number);
+			default:
+				return snprintf(line, MAX_GENERATED_LINE, "First%ld Last%ld %d.%03d X\n", number, number, whole,
+					thousandths);
+		}
+	}
+
+	if (is_domestic) {
+		return snprintf(line, MAX_GENERATED_LINE, "First%ld Last%ld %d.%03d D\n", number, number, whole,
+			thousandths);
+	}
+	return snprintf(line, MAX_GENERATED_LINE, "First%ld Last%ld %d.%03d I %d\n", number, number, whole, thousandths,
+		toefl);
+}
+
+//Function to set config to the defaults.
+void generator_defaults(RosterConfig *config) {
+	config->records            = 1000000;
+	config->international_rate = 0.5;
+	config->gpa_distribution   = GPA_UNIFORM;
+	config->gpa_mean           = 3.0;
+	config->gpa_stddev         = 0.5;
+	config->malformed_rate     = 0.0;
+	config->seed               = 2510;
+}
+
+//Function to make the roster text.
+char *generate_roster(const RosterConfig *config, size_t *size) {
+	size_t capacity   = (size_t)config->records * MAX_GENERATED_LINE + 1;
+	char *text        = malloc(capacity);
+	unsigned int seed = config->seed;
+
+	//Throwing an error, if memory allocation failed.
+	if (text == NULL) {
+		puts("Memory allocation for roster failed :(\n");
+		exit(1);
+	}
+
+	*size = 0;
+	for (long i = 0; i < config->records; i++) {
+		*size += make_line(config, &seed, i, text + *size);
+	}
+	return text;
+}
@@ -0,0 +1,38 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: Has the synthetic roster generator and its function prototypes (Used by Lab6_bench).
+*          Makes the text of an N line roster in the Students.txt format. The same settings and seed always make
+*          the same roster. The domestic/international mix, the gpa distribution and the rate of malformed lines
+*          can be set.
+*          Malformed lines are a missing field, a missing or <= 0 TOEFL, an unreadable gpa or an unknown status.
+*          Lab6 stops at a line with a missing field, so rosters made for Lab6 itself should use malformed_rate 0.
+*/
+#ifndef GENERATOR_H //Checking if GENERATOR_H is not defined
+#define GENERATOR_H
+
+#include <stddef.h>
+
+#define GPA_UNIFORM 0 //Gpa spread evenly over 0.001 ~ 4.300
+#define GPA_NORMAL 1 //Gpa around gpa_mean with gpa_stddev (Kept in 0.001 ~ 4.300)
+
+#define GENERATOR_MAX_GPA 4300 //Highest generated gpa in thousandths.
+
+typedef struct {                //Roster generator settings
+    long records;               //Number of lines
+    double international_rate;  //Share of international students (0 ~ 1)
+    int gpa_distribution;       //GPA_UNIFORM or GPA_NORMAL
+    double gpa_mean;            //Mean gpa for GPA_NORMAL
+    double gpa_stddev;          //Standard deviation of gpa for GPA_NORMAL
+    double malformed_rate;      //Share of malformed lines (0 ~ 1)
+    unsigned int seed;          //Same seed, same roster
+} RosterConfig;
+
+//Function to set config to the defaults: 1M records, half international, uniform gpa, no malformed lines
+void generator_defaults(RosterConfig *config);
+
+//Function to make the roster text (Every line ends with '\n'). Returns the text, its size is in *size.
+//Caller frees the text.
+char *generate_roster(const RosterConfig *config, size_t *size);
+
+#endif // Ending #ifndef block
@@ -0,0 +1,196 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: ingest.c has implemented functions for reading the whole input into the student table.
+*		   ingest_serial() Reading every line into the table on the calling thread.
+*		   ingest_parallel() Splitting the input at newlines and parsing each chunk on its own thread.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "ingest.h"
+
+typedef struct {                //One rejected line of a chunk
+    long line_index;            //Line in the chunk (0 for its first line)
+    int result;                 //PARSE_ result
+} RejectedLine;
+
+typedef struct {                //Work of one thread
+    const char *start;          //First byte of the chunk (Always the start of a line)
+    const char *end;            //One past the last byte of the chunk
+    StudentTable table;         //Students parsed from the chunk
+    int invalid_toefl_count;    //Number of "Invalid TOEFL score" messages owed before stopping
+    int missing_field;          //1 if the chunk stopped at a line with a missing field
+    int resilient;              //1 to keep bad lines for the reject file instead of stopping (--rejects)
+    int limit_line_length;      //1 to reject lines longer than MAX_LINE_LENGTH (Resilient only)
+    long lines;                 //Lines read (Counter)
+    RejectedLine *rejected;     //Rejected lines in order, written to the reject file after the join (Resilient only)
+    long num_of_rejected;       //Number of rejected lines
+    long rejected_capacity;     //Number of rejected lines rejected can hold
+} IngestChunk;
+
+//Function to read every line of the input into the table on the calling thread.
+void ingest_serial(InputReader *reader, StudentTable *table, RejectLog *rejects) {
+	Slice file_line;
+
+	while (input_next_line(reader, &file_line)) {
+		if (rejects == NULL) {
+			report_parse_result(parse_line_into_table(file_line, table));
+		} else if (!reject_count_line(rejects, rejects->limit_line_length ?
+			parse_line_into_table_limited(file_line, table) : parse_line_into_table(file_line, table))) {
+			return;
+		}
+	}
+}
+
+//Function to keep the last line read by the chunk as rejected (Doubling the list when it's full).
+static void add_rejected_line(IngestChunk *chunk, int result) {
+	if (chunk->num_of_rejected == chunk->rejected_capacity) {
+		long capacity = chunk->rejected_capacity > 0 ? chunk->rejected_capacity * 2 : 64;
+		RejectedLine *rejected = realloc(chunk->rejected, capacity * sizeof(RejectedLine));
+
+		//Throwing an error, if memory allocation failed.
+		if (rejected == NULL) {
+			puts("Memory allocation for rejected lines failed :(\n");
+			exit(1);
+		}
+		chunk->rejected          = rejected;
+		chunk->rejected_capacity = capacity;
+	}
+	chunk->rejected[chunk->num_of_rejected++] = (RejectedLine){chunk->lines - 1, result};
+}
+
+//Function run by each thread: parses its chunk until the end or the first line with a missing field.
+static void *ingest_chunk(void *argument) {
+	IngestChunk *chunk = argument;
+	const char *current = chunk->start;
+
+	while (current < chunk->end) {
+		const char *newline = memchr(current, '\n', chunk->end - current);
+		const char *line_end = newline != NULL ? newline : chunk->end;
+		Slice file_line = {current, line_end - current};
+
+		int result = chunk->limit_line_length ? parse_line_into_table_limited(file_line, &chunk->table) :
+			parse_line_into_table(file_line, &chunk->table);
+		chunk->lines++;
+
+		if (chunk->resilient) {
+			//Bad lines are kept for the reject file. The reject rate is checked at the join, over the whole input.
+			if (result != PARSE_OK) {
+				add_rejected_line(chunk, result);
+			}
+		} else if (result == PARSE_INVALID_TOEFL) {
+			chunk->invalid_toefl_count++;
+		} else if (result == PARSE_MISSING_FIELD) {
+			chunk->missing_field = 1;
+			break;
+		}
+		current = line_end + 1;
+	}
+	return NULL;
+}
+
+//Function to add a chunk's rejected lines to the reject log with their line number in the whole input.
+//The reject rate is checked after each one over every line before it, like reject_count_line() does, so the run
+//stops at the same line (With the same message) as ingest_serial(), whatever the number of threads.
+static void join_rejected_lines(RejectLog *rejects, const IngestChunk *chunk) {
+	for (long j = 0; j < chunk->num_of_rejected; j++) {
+		long line_index = rejects->lines + chunk->rejected[j].line_index;
+
+		reject_line(rejects, line_index, chunk->rejected[j].result);
+		if (reject_rate_exceeded(line_index + 1, rejects->rejected, rejects->max_rate)) {
+			rejects->lines   = line_index + 1;
+			rejects->aborted = 1;
+			return;
+		}
+	}
+	rejects->lines += chunk->lines;
+}
+
+//Function to read every line of the input into the table with up to num_of_threads threads.
+void ingest_parallel(InputReader *reader, StudentTable *table, int num_of_threads, RejectLog *rejects) {
+	size_t size = reader->size - reader->position;
+
+	//Using fewer threads for small inputs.
+	if (num_of_threads > (int)(size / MIN_CHUNK_SIZE)) {
+		num_of_threads = (int)(size / MIN_CHUNK_SIZE);
+	}
+	if (!reader->mapped || num_of_threads <= 1) {
+		ingest_serial(reader, table, rejects);
+		return;
+	}
+
+	IngestChunk *chunks = calloc(num_of_threads, sizeof(IngestChunk));
+	pthread_t *threads  = malloc(num_of_threads * sizeof(pthread_t));
+
+	//Throwing an error, if memory allocation failed.
+	if (chunks == NULL || threads == NULL) {
+		puts("Memory allocation for ingest threads failed :(\n");
+		exit(1);
+	}
+
+	//Splitting the input into equal chunks, moving each boundary to just after the next '\n'.
+	const char *data = reader->data + reader->position;
+	const char *previous_end = data;
+	for (int i = 0; i < num_of_threads; i++) {
+		const char *end = data + size * (i + 1) / num_of_threads;
+
+		if (end < previous_end) {
+			end = previous_end;
+		}
+		if (i < num_of_threads - 1 && end < data + size) {
+			const char *newline = memchr(end, '\n', data + size - end);
+			end = newline != NULL ? newline + 1 : data + size;
+		} else {
+			end = data + size;
+		}
+
+		chunks[i].start = previous_end;
+		chunks[i].end   = end;
+		chunks[i].resilient         = rejects != NULL;
+		chunks[i].limit_line_length = rejects != NULL && rejects->limit_line_length;
+		table_init_for_input(&chunks[i].table, end - previous_end);
+		previous_end = end;
+	}
+
+	for (int i = 0; i < num_of_threads; i++) {
+		if (pthread_create(&threads[i], NULL, ingest_chunk, &chunks[i]) != 0) {
+			puts("Creating ingest thread failed :/\n");
+			exit(1);
+		}
+	}
+	for (int i = 0; i < num_of_threads; i++) {
+		pthread_join(threads[i], NULL);
+	}
+
+	//Joining tables and printing messages in input order, so the run looks exactly like ingest_serial().
+	int total_count = table->count;
+	size_t total_pool_size = table->pool_size;
+	for (int i = 0; i < num_of_threads; i++) {
+		total_count     += chunks[i].table.count;
+		total_pool_size += chunks[i].table.pool_size;
+	}
+	table_reserve(table, total_count, total_pool_size);
+
+	for (int i = 0; i < num_of_threads; i++) {
+		for (int j = 0; j < chunks[i].invalid_toefl_count; j++) {
+			report_parse_result(PARSE_INVALID_TOEFL);
+		}
+		if (chunks[i].missing_field) {
+			report_parse_result(PARSE_MISSING_FIELD);
+		}
+
+		if (rejects != NULL && !rejects->aborted) {
+			join_rejected_lines(rejects, &chunks[i]);
+		}
+		table_append_table(table, &chunks[i].table);
+		table_free(&chunks[i].table);
+		free(chunks[i].rejected);
+	}
+
+	reader->position = reader->size;
+	free(chunks);
+	free(threads);
+}
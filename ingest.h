@@ -0,0 +1,26 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: Has the function prototypes for reading the whole input into the student table.
+*          Serial ingest goes line by line. Parallel ingest splits a memory-mapped input at newlines,
+*          parses each chunk into its own table on its own thread and joins the tables in input order.
+*/
+#ifndef INGEST_H //Checking if INGEST_H is not defined
+#define INGEST_H
+
+#include "input.h"
+#include "table.h"
+#include "reject.h"
+
+#define MIN_CHUNK_SIZE (64 * 1024) //Smallest chunk given to a thread, so small inputs don't start extra threads.
+
+//Function to read every line of the input into the table on the calling thread
+//With a reject log (--rejects), bad lines go to it instead of stopping the run, until its reject rate is too high
+//(rejects->aborted is set then). With NULL, messages are printed and a missing field exits, like before.
+void ingest_serial(InputReader *reader, StudentTable *table, RejectLog *rejects);
+
+//Function to read every line of the input (From the reader's position) into the table with up to num_of_threads threads
+//Falls back to ingest_serial() if the input isn't memory-mapped. Result is the same as ingest_serial().
+void ingest_parallel(InputReader *reader, StudentTable *table, int num_of_threads, RejectLog *rejects);
+
+#endif // Ending #ifndef block
@@ -0,0 +1,267 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: input.c has implemented functions for the zero-copy input reader.
+*		   input_open() Memory-mapping a regular file, or setting up a read buffer for a stream.
+*		   input_open_buffered() Setting up a read buffer, without memory-mapping.
+*		   input_next_line() Handing out the next line as a slice.
+*		   split_fields() Splitting a line into fields separated by spaces.
+*		   parse_gpa() Reading a gpa field as GPA_SCALE x thousandths.
+*		   parse_toefl() Reading a TOEFL field as int.
+*		   input_close() Unmapping or freeing the reader's memory.
+*/
+
+#define _POSIX_C_SOURCE 200809L //For fileno() and posix_madvise()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "input.h"
+
+#define MAX_GPA_WHOLE 500000 //Largest whole part of a gpa, so GPA_SCALE x thousandths fits in an int.
+
+//Function to set up the reader for an opened file.
+void input_open(InputReader *reader, FILE *file) {
+	struct stat file_status;
+
+	reader->fd          = fileno(file);
+	reader->mapped      = 0;
+	reader->data        = NULL;
+	reader->size        = 0;
+	reader->capacity    = 0;
+	reader->position    = 0;
+	reader->end_of_file = 0;
+
+	//Memory-mapping regular files. An empty file has nothing to map.
+	if (fstat(reader->fd, &file_status) == 0 && S_ISREG(file_status.st_mode)) {
+		if (file_status.st_size == 0) {
+			reader->mapped      = 1;
+			reader->end_of_file = 1;
+			return;
+		}
+
+		void *mapping = mmap(NULL, file_status.st_size, PROT_READ, MAP_PRIVATE, reader->fd, 0);
+		if (mapping != MAP_FAILED) {
+			posix_madvise(mapping, file_status.st_size, POSIX_MADV_SEQUENTIAL);
+			reader->mapped      = 1;
+			reader->data        = mapping;
+			reader->size        = file_status.st_size;
+			reader->end_of_file = 1;
+			return;
+		}
+	}
+
+	//Pipes (and files that can't be mapped) are read in blocks.
+	input_open_buffered(reader, file);
+}
+
+//Function to set up the reader to read the file in blocks, even if it could be memory-mapped.
+void input_open_buffered(InputReader *reader, FILE *file) {
+	reader->fd          = fileno(file);
+	reader->mapped      = 0;
+	reader->data        = malloc(INPUT_BUFFER_SIZE);
+	reader->size        = 0;
+	reader->capacity    = INPUT_BUFFER_SIZE;
+	reader->position    = 0;
+	reader->end_of_file = 0;
+
+	//Throwing an error, if memory allocation failed.
+	if (reader->data == NULL) {
+		puts("Memory allocation for input buffer failed :(\n");
+		exit(1);
+	}
+}
+
+//Function to read more of the stream into the buffer. Keeps the unfinished line at the front.
+static void fill_buffer(InputReader *reader) {
+
+	//Moving the unfinished line to the front of the buffer.
+	size_t remaining = reader->size - reader->position;
+	memmove(reader->data, reader->data + reader->position, remaining);
+	reader->size     = remaining;
+	reader->position = 0;
+
+	//Doubling the buffer if one line fills all of it (Lines are never cut).
+	if (reader->size == reader->capacity) {
+		reader->capacity *= 2;
+		reader->data = realloc(reader->data, reader->capacity);
+
+		//Throwing an error, if memory reallocation failed.
+		if (reader->data == NULL) {
+			puts("Memory reallocation for input buffer failed :/ \n");
+			exit(1);
+		}
+	}
+
+	ssize_t bytes_read = read(reader->fd, reader->data + reader->size, reader->capacity - reader->size);
+
+	//Throwing an error, if reading failed.
+	if (bytes_read < 0) {
+		puts("Reading input file failed :/\n");
+		exit(1);
+	}
+	if (bytes_read == 0) {
+		reader->end_of_file = 1;
+	}
+	reader->size += bytes_read;
+}
+
+//Function to get the next line without its '\n'.
+int input_next_line(InputReader *reader, Slice *line) {
+	for (;;) {
+		const char *start   = reader->data + reader->position;
+		size_t remaining    = reader->size - reader->position;
+		const char *newline = remaining > 0 ? memchr(start, '\n', remaining) : NULL;
+
+		if (newline != NULL) {
+			line->start      = start;
+			line->length     = newline - start;
+			reader->position += line->length + 1;
+			return 1;
+		}
+
+		//Last line of the input doesn't need a '\n'.
+		if (reader->end_of_file) {
+			if (remaining == 0) {
+				return 0;
+			}
+			line->start      = start;
+			line->length     = remaining;
+			reader->position = reader->size;
+			return 1;
+		}
+		fill_buffer(reader);
+	}
+}
+
+//Function to split a line into fields separated by spaces (Same splitting as strtok(line, " ")).
+int split_fields(Slice line, Slice fields[], int max_fields) {
+	const char *current = line.start;
+	const char *end     = line.start + line.length;
+	int num_of_fields   = 0;
+
+	while (num_of_fields < max_fields) {
+
+		//Skipping spaces between fields.
+		while (current < end && *current == ' ') {
+			current++;
+		}
+		if (current == end) {
+			break;
+		}
+
+		const char *field_start = current;
+		while (current < end && *current != ' ') {
+			current++;
+		}
+		fields[num_of_fields].start  = field_start;
+		fields[num_of_fields].length = current - field_start;
+		num_of_fields++;
+	}
+	return num_of_fields;
+}
+
+//Function to read a gpa like "3.125" as GPA_SCALE x thousandths (12500). Returns 0 if the field isn't a plain
+//decimal number. Digits past the thousandths add 1 if they are under half a thousandth ("3.9004" -> 15601), or
+//GPA_SCALE - 1 if they are half or more ("3.9995" -> 15999, written as 4.000). Doesn't depend on the locale.
+int parse_gpa(Slice field, int *gpa) {
+	const char *current = field.start;
+	const char *end     = field.start + field.length;
+	int whole           = 0;
+	int fraction        = 0;
+	int extra           = 0;
+	int num_of_digits   = 0;
+
+	if (current < end && *current == '+') {
+		current++;
+	}
+	while (current < end && *current >= '0' && *current <= '9') {
+		whole = whole * 10 + (*current - '0');
+		num_of_digits++;
+		current++;
+
+		//Throwing an error, if gpa doesn't fit in an int as thousandths.
+		if (whole > MAX_GPA_WHOLE) {
+			return 0;
+		}
+	}
+
+	if (current < end && *current == '.') {
+		int place = 0;
+		current++;
+
+		//First three decimal places are the thousandths. The rest only say where between two thousandths it is.
+		while (current < end && *current >= '0' && *current <= '9') {
+			if (place < 3) {
+				fraction = fraction * 10 + (*current - '0');
+			} else if (place == 3 && *current >= '5') {
+				extra = GPA_SCALE - 1;
+			} else if (extra == 0 && *current != '0') {
+				extra = 1;
+			}
+			place++;
+			num_of_digits++;
+			current++;
+		}
+
+		//Scaling up when there are fewer than three decimal places ("3.5" -> 500).
+		for (; place < 3; place++) {
+			fraction *= 10;
+		}
+	}
+
+	//Throwing an error, if there are no digits or something follows the number.
+	if (num_of_digits == 0 || current != end) {
+		return 0;
+	}
+	*gpa = (whole * 1000 + fraction) * GPA_SCALE + extra;
+	return 1;
+}
+
+//Function to read a TOEFL score like "100". Returns 0 if the field isn't a plain whole number.
+//A '\r' at the end (Windows line ending) is allowed, like atoi().
+int parse_toefl(Slice field, int *toefl) {
+	const char *current = field.start;
+	const char *end     = field.start + field.length;
+	int negative        = 0;
+	int value           = 0;
+
+	if (end > current && end[-1] == '\r') {
+		end--;
+	}
+	if (current < end && (*current == '+' || *current == '-')) {
+		negative = *current == '-';
+		current++;
+	}
+
+	//Throwing an error, if there are no digits.
+	if (current == end) {
+		return 0;
+	}
+	while (current < end) {
+
+		//Throwing an error, if it isn't a digit or TOEFL doesn't fit in an int.
+		if (*current < '0' || *current > '9' || value > (0x7FFFFFFF - (*current - '0')) / 10) {
+			return 0;
+		}
+		value = value * 10 + (*current - '0');
+		current++;
+	}
+	*toefl = negative ? -value : value;
+	return 1;
+}
+
+//Function to unmap or free the reader's memory.
+void input_close(InputReader *reader) {
+	if (reader->mapped) {
+		if (reader->data != NULL) {
+			munmap(reader->data, reader->size);
+		}
+	} else {
+		free(reader->data);
+	}
+	reader->data = NULL;
+}
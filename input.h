@@ -0,0 +1,69 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: Has the zero-copy input reader and its function prototypes.
+*          Regular files are memory-mapped and lines are handed out as (pointer, length) slices into the mapping.
+*          Pipes and other streams fall back to buffered read() calls into a growing buffer.
+*          Lines have no length limit and fields are never copied while parsing.
+*/
+#ifndef INPUT_H //Checking if INPUT_H is not defined
+#define INPUT_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#define INPUT_BUFFER_SIZE (64 * 1024) //First size of the read buffer when the input can't be memory-mapped.
+#define MAX_FIELDS 5 //First name, last name, GPA, student status, TOEFL.
+#define GPA_SCALE 4 //Gpa is kept as GPA_SCALE x thousandths, so one between two thousandths still compares right.
+
+typedef struct {        //Piece of a line (Not null terminated)
+    const char *start;  //First character
+    size_t length;      //Number of characters
+} Slice;
+
+typedef struct {        //Input reader
+    int fd;             //File descriptor of the input file
+    int mapped;         //1 if data is a memory mapping of the whole file, 0 if it's the read buffer
+    char *data;         //Mapped file, or read buffer
+    size_t size;        //Bytes of the mapping, or bytes currently in the read buffer
+    size_t capacity;    //Bytes allocated for the read buffer
+    size_t position;    //Where the next line starts
+    int end_of_file;    //1 once read() has returned 0
+} InputReader;
+
+//Function to set up the reader for an opened file (Memory-maps it if it's a regular file)
+void input_open(InputReader *reader, FILE *file);
+
+//Function to set up the reader to read the file in blocks, even if it could be memory-mapped
+//Memory stays at the buffer size (Plus the longest line), where a mapping keeps every page it has read.
+void input_open_buffered(InputReader *reader, FILE *file);
+
+//Function to get the next line without its '\n'. Returns 0 at the end of the input.
+//When reading a stream, the line is only valid until the next call.
+int input_next_line(InputReader *reader, Slice *line);
+
+//Function to split a line into fields separated by spaces. Returns the number of fields found.
+int split_fields(Slice line, Slice fields[], int max_fields);
+
+//Function to read a gpa field as GPA_SCALE x thousandths ("3.125" -> 12500). Returns 0 if it isn't a decimal number.
+//A gpa with more decimal places is 1 above the thousandths under it, or 1 below the one it rounds up to, so
+//"gpa > 3.9" keeps "3.9004" (Like strtof() did) while it's still written as 3.900.
+int parse_gpa(Slice field, int *gpa);
+
+//Function to get a gpa as GPA_SCALE x thousandths from thousandths (3125 -> 12500)
+static inline int gpa_from_thousandths(int thousandths) {
+    return thousandths * GPA_SCALE;
+}
+
+//Function to get the thousandths a gpa is written with (Rounded half up, like "%.3f")
+static inline int gpa_to_thousandths(int gpa) {
+    return (gpa + 1) / GPA_SCALE;
+}
+
+//Function to read a TOEFL field as int. Returns 0 if it isn't a whole number.
+int parse_toefl(Slice field, int *toefl);
+
+//Function to unmap or free the reader's memory
+void input_close(InputReader *reader);
+
+#endif // Ending #ifndef block
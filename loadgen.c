@@ -0,0 +1,260 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: Load generator for the query server (Lab6 --serve).
+*          Usage: Lab6_load <socket file> [--clients N] [--requests N] [--query <option or query>]...
+*          Each client is a thread with its own connection, sending --requests requests one after another and
+*          waiting for each reply. Queries are taken in turn (Options 1 ~ 4 if --query isn't given).
+*          Prints throughput and latency percentiles (p50, p90, p99, max) of every request as JSON.
+*/
+
+#define _POSIX_C_SOURCE 200809L //For clock_gettime()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "server.h"
+
+#define DEFAULT_CLIENTS SERVER_DEFAULT_WORKERS //Client threads if --clients isn't given (One per server worker).
+#define DEFAULT_REQUESTS 1000 //Requests per client if --requests isn't given.
+#define MAX_QUERIES 16 //Most --query options.
+#define REPLY_BUFFER_SIZE (64 * 1024) //Bytes read from the socket at a time.
+
+typedef struct {                //Work of one client thread
+    const char *socket_file_name; //Server socket
+    const char **queries;       //Requests sent in turn
+    int num_of_queries;         //Number of queries
+    int first_query;            //Query of this client's first request (So clients don't all send the same one)
+    int num_of_requests;        //Requests to send
+    double *latencies;          //Seconds of each request (num_of_requests of them)
+    long errors;                //Replies starting with "ERR" (Counter)
+    long bytes;                 //Reply bytes read (Counter)
+    int failed;                 //1 if the connection failed
+} LoadClient;
+
+//Function to get current time in seconds.
+static double now_seconds(void) {
+	struct timespec time_now;
+	clock_gettime(CLOCK_MONOTONIC, &time_now);
+	return time_now.tv_sec + time_now.tv_nsec / 1e9;
+}
+
+//Function to connect to the server. Returns -1 if it can't.
+static int connect_to_server(const char *socket_file_name) {
+	struct sockaddr_un address;
+
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (strlen(socket_file_name) >= sizeof(address.sun_path)) {
+		return -1;
+	}
+	strcpy(address.sun_path, socket_file_name);
+
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd >= 0 && connect(fd, (struct sockaddr *)&address, sizeof(address)) != 0) {
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+//Function to send a whole request line. Returns 0 if the connection failed.
+static int send_request(int fd, const char *query) {
+	char request[SERVER_MAX_REQUEST + 2];
+	int length = snprintf(request, sizeof(request), "%s\n", query);
+	const char *position = request;
+
+	while (length > 0) {
+		ssize_t bytes_sent = write(fd, position, length);
+
+		if (bytes_sent < 0 && errno == EINTR) {
+			continue;
+		}
+		if (bytes_sent <= 0) {
+			return 0;
+		}
+		position += bytes_sent;
+		length   -= bytes_sent;
+	}
+	return 1;
+}
+
+//Function to read one reply until its empty line. Returns bytes read, or -1 if the connection failed.
+//is_error is set to 1 if the reply starts with "ERR".
+static long read_reply(int fd, char *buffer, int *is_error) {
+	long total = 0;
+	char last_two[2] = {0, 0};
+
+	for (;;) {
+		ssize_t bytes_read = read(fd, buffer, REPLY_BUFFER_SIZE);
+
+		if (bytes_read < 0 && errno == EINTR) {
+			continue;
+		}
+		if (bytes_read <= 0) {
+			return -1;
+		}
+		if (total == 0) {
+			*is_error = bytes_read >= 3 && memcmp(buffer, "ERR", 3) == 0;
+		}
+		total += bytes_read;
+
+		//Student lines are never empty, so "\n\n" only shows up at the end of the reply.
+		if (bytes_read >= 2) {
+			last_two[0] = buffer[bytes_read - 2];
+		} else {
+			last_two[0] = last_two[1];
+		}
+		last_two[1] = buffer[bytes_read - 1];
+		if (last_two[0] == '\n' && last_two[1] == '\n') {
+			return total;
+		}
+	}
+}
+
+//Function run by each client thread: sends its requests one at a time and times each reply.
+static void *run_client(void *argument) {
+	LoadClient *client = argument;
+	char *buffer = malloc(REPLY_BUFFER_SIZE);
+	int fd = connect_to_server(client->socket_file_name);
+
+	if (buffer == NULL || fd < 0) {
+		client->failed = 1;
+		free(buffer);
+		return NULL;
+	}
+
+	for (int i = 0; i < client->num_of_requests; i++) {
+		const char *query = client->queries[(client->first_query + i) % client->num_of_queries];
+		int is_error = 0;
+		double start = now_seconds();
+
+		long bytes = send_request(fd, query) ? read_reply(fd, buffer, &is_error) : -1;
+		if (bytes < 0) {
+			client->failed = 1;
+			client->num_of_requests = i;
+			break;
+		}
+		client->latencies[i] = now_seconds() - start;
+		client->bytes  += bytes;
+		client->errors += is_error;
+	}
+	close(fd);
+	free(buffer);
+	return NULL;
+}
+
+//Function to compare two latencies for qsort().
+static int compare_latency(const void *first, const void *second) {
+	double a = *(const double *)first;
+	double b = *(const double *)second;
+	return (a > b) - (a < b);
+}
+
+//Function to get the latency below which percent of the sorted latencies are, in milliseconds.
+static double percentile_ms(const double *sorted, long count, double percent) {
+	long index = (long)(percent / 100.0 * count + 0.5) - 1;
+
+	if (index < 0) {
+		index = 0;
+	}
+	if (index >= count) {
+		index = count - 1;
+	}
+	return sorted[index] * 1000.0;
+}
+
+int main(int argc, char *argv[]) {
+	if (argc < 2) {
+		puts("Usage: Lab6_load <socket file> [--clients N] [--requests N] [--query <option or query>]...");
+		return 1;
+	}
+
+	const char *default_queries[] = {"1", "2", "3", "4"};
+	const char *queries[MAX_QUERIES];
+	int num_of_queries  = 0;
+	int num_of_clients  = DEFAULT_CLIENTS;
+	int num_of_requests = DEFAULT_REQUESTS;
+
+	for (int i = 2; i < argc; i++) {
+		if (strcmp(argv[i], "--clients") == 0 && i + 1 < argc) {
+			num_of_clients = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "--requests") == 0 && i + 1 < argc) {
+			num_of_requests = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "--query") == 0 && i + 1 < argc && num_of_queries < MAX_QUERIES) {
+			queries[num_of_queries++] = argv[++i];
+		} else {
+			printf("Unknown argument: %s :p\n", argv[i]);
+			return 1;
+		}
+	}
+	if (num_of_clients <= 0 || num_of_requests <= 0) {
+		puts("--clients and --requests have to be at least 1 :p\n");
+		return 1;
+	}
+	if (num_of_queries == 0) {
+		memcpy(queries, default_queries, sizeof(default_queries));
+		num_of_queries = 4;
+	}
+
+	LoadClient *clients  = calloc(num_of_clients, sizeof(LoadClient));
+	pthread_t *threads   = malloc(num_of_clients * sizeof(pthread_t));
+	double *latencies    = malloc((size_t)num_of_clients * num_of_requests * sizeof(double));
+
+	//Throwing an error, if memory allocation failed.
+	if (clients == NULL || threads == NULL || latencies == NULL) {
+		puts("Memory allocation for load generator failed :(\n");
+		return 1;
+	}
+
+	double start = now_seconds();
+	for (int i = 0; i < num_of_clients; i++) {
+		clients[i] = (LoadClient){argv[1], queries, num_of_queries, i % num_of_queries, num_of_requests,
+			latencies + (size_t)i * num_of_requests, 0, 0, 0};
+
+		if (pthread_create(&threads[i], NULL, run_client, &clients[i]) != 0) {
+			puts("Creating client thread failed :/\n");
+			return 1;
+		}
+	}
+
+	long total_requests = 0;
+	long errors         = 0;
+	long bytes          = 0;
+	int failed_clients  = 0;
+	for (int i = 0; i < num_of_clients; i++) {
+		pthread_join(threads[i], NULL);
+
+		//Moving each client's latencies together, so they can be sorted as one array.
+		memmove(latencies + total_requests, clients[i].latencies, clients[i].num_of_requests * sizeof(double));
+		total_requests += clients[i].num_of_requests;
+		errors         += clients[i].errors;
+		bytes          += clients[i].bytes;
+		failed_clients += clients[i].failed;
+	}
+	double seconds = now_seconds() - start;
+
+	if (total_requests == 0) {
+		printf("No request got a reply from %s :(\n\n", argv[1]);
+		return 1;
+	}
+	qsort(latencies, total_requests, sizeof(double), compare_latency);
+
+	printf("{\"clients\": %d, \"requests\": %ld, \"errors\": %ld, \"failed_clients\": %d, \"seconds\": %.6f, "
+		"\"requests_per_second\": %.1f, \"reply_bytes\": %ld,\n", num_of_clients, total_requests, errors,
+		failed_clients, seconds, total_requests / seconds, bytes);
+	printf(" \"latency_ms\": {\"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f}}\n",
+		percentile_ms(latencies, total_requests, 50.0), percentile_ms(latencies, total_requests, 90.0),
+		percentile_ms(latencies, total_requests, 99.0), latencies[total_requests - 1] * 1000.0);
+
+	free(clients);
+	free(threads);
+	free(latencies);
+	return failed_clients > 0;
+}
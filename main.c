@@ -6,96 +6,351 @@
 *          Option2 - Only international students with GPA > 3.9 && TOEFL >= 70.
 *          Option3 - All students with GPA > 3.9 (Domestic and International with TOEFL >= 70).
 *          Option4 - All students with GPA in descending order.
+*          Option can also be a query spec, like "gpa>3.5 and toefl>=80 and status=I order by gpa desc limit 100".
+*          Usage: Lab6 <input file> <output file> <option or query> [-j threads] [--stream] [--out-buffer bytes]
+*                      [--also <output file> <option or query>]... [--top N] [--snapshot <snapshot file> [--append-only]]
+*                      [--stats] [--rejects <reject file> [--max-reject-rate rate]]
+*          -j N also sorts by gpa (Option 4) on N threads, with the same order as one thread.
+*          --top N only writes the N best students by gpa (Option 4 without sorting everyone, works with --stream).
+*          --snapshot keeps the parsed table (And its gpa order) in a binary file. Later runs on the same unchanged
+*          input memory-map it instead of parsing, and option 4 walks the stored gpa order instead of sorting.
+*          --append-only says the input only grows, so only lines added since the snapshot are parsed and merged in.
+*          The snapshot isn't read or written with --rejects, so every bad line is in the reject file each run.
+*          --also adds more outputs to the same run (Batch). The input is parsed once and every query shares one scan.
+*          --stats prints wall time per stage, lines accepted and rejected, reallocations and peak RSS as JSON (stderr).
+*          --rejects writes every bad line (Missing field, TOEFL <= 0, longer than MAX_LINE_LENGTH, ...) to the reject
+*          file as "<line number> <reason>" and keeps reading, instead of stopping at a missing field.
+*          The run still stops once more than rate (0 ~ 1, default 0.1) of the lines read are rejected.
+*
+*          Server mode: Lab6 --serve <input file> <socket file> [-j threads] [--workers N] [--out-buffer bytes]
+*          Keeps the parsed roster in memory and answers options or query specs sent as lines over a Unix domain
+*          socket (See server.h), loading the roster again when the file changes. Stops on Ctrl+C.
 */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
+#include <string.h>
 #include "student.h"
+#include "table.h"
+#include "ingest.h"
+#include "stream.h"
+#include "query.h"
+#include "snapshot.h"
+#include "stats.h"
+#include "server.h"
+#include "reject.h"
+
+#define MAX_BATCH 16 //Most outputs in one run (The main one and every --also).
+
+//Function to compile an option (1 ~ 4) or a query spec. Stops the run if it's wrong (Each spec on its own).
+static void compile_query(const char *query_spec, Query *query) {
+    char error[QUERY_ERROR_SIZE];
+
+    //Throwing an error, if there is no such option or the query spec is wrong.
+    if (!query_compile(query_spec, query, error, sizeof(error))) {
+        printf("%s :(\n\n", error);
+        exit(1);
+    }
+}
+
+//Function to write what's left of the reject file and close it. Stops the run if there were too many rejected lines.
+static void close_rejects(RejectLog *rejects, FILE *file3) {
+    if (rejects == NULL) {
+        return;
+    }
+    reject_end_of_input(rejects);
+    reject_close(rejects);
+    fclose(file3);
+
+    if (rejects->aborted) {
+        reject_abort(rejects);
+    }
+}
+
+//Function to read the arguments of server mode (After --serve) and run the server.
+static int run_server(int argc, char *argv[]) {
+    //argc has at least 4 arguments(Program name, --serve, Input file, Socket file), then optional flags.
+    if (argc < 4) {
+        puts("Not enough arguments for --serve :p\n");
+        exit(1);
+    }
+
+    ServerConfig config = {argv[2], argv[3], SERVER_DEFAULT_WORKERS, 1, WRITER_BUFFER_SIZE};
+
+    for (int i = 4; i < argc; i++) {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            config.threads = atoi(argv[++i]);
+
+            //Throwing an error, if thread count isn't a positive number.
+            if (config.threads <= 0) {
+                puts("Number of threads (-j) has to be at least 1 :p\n");
+                exit(1);
+            }
+        } else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            config.workers = atoi(argv[++i]);
+
+            //Throwing an error, if worker count isn't a positive number.
+            if (config.workers <= 0) {
+                puts("Number of workers (--workers) has to be at least 1 :p\n");
+                exit(1);
+            }
+        } else if (strcmp(argv[i], "--out-buffer") == 0 && i + 1 < argc) {
+            config.output_buffer_size = atol(argv[++i]);
+
+            //Throwing an error, if buffer size isn't a positive number.
+            if (config.output_buffer_size <= 0) {
+                puts("Output buffer size (--out-buffer) has to be at least 1 byte :p\n");
+                exit(1);
+            }
+        } else {
+            printf("Unknown argument: %s :p\n", argv[i]);
+            exit(1);
+        }
+    }
+
+    server_run(&config);
+    return 0;
+}
 
 int main( int argc, char *argv[]) {
 
-    //argc has 4 arguments(Program name, Input file, Output file, Options).
-    if(argc < 4 || argc > 5) {
+    //Server mode keeps the roster in memory and answers queries over a socket.
+    if (argc > 1 && strcmp(argv[1], "--serve") == 0) {
+        return run_server(argc, argv);
+    }
+
+    //argc has at least 4 arguments(Program name, Input file, Output file, Options), then optional flags.
+    if(argc < 4) {
         puts("Not enough arguments or more arguments have been typed :p\n");
         exit(1);
     }
 
     const char* input_file_name     = argv[1];          //Input file for reading
-    const char* output_file_name    = argv[2];          //Output file for writing
-    int options                     = atoi(argv[3]);    //Options to choose which files want to be written
+    const char* output_file_names[MAX_BATCH] = {argv[2]}; //Output files for writing
+    const char* query_specs[MAX_BATCH]       = {argv[3]}; //Option 1 ~ 4, or a query spec, for each output
+    int num_of_outputs              = 1;                //Main output plus one for each --also
+    int num_of_threads              = 1;                //Threads for parsing (-j N)
+    int stream_mode                 = 0;                //1 to filter while reading, without a table (--stream)
+    long output_buffer_size         = WRITER_BUFFER_SIZE; //Bytes of output formatted before each write (--out-buffer)
+    int top                         = NO_LIMIT;         //Only the best N students by gpa (--top N)
+    const char* snapshot_file_name  = NULL;             //Binary snapshot of the parsed table (--snapshot)
+    int append_only                 = 0;                //1 if the input only grows at the end (--append-only)
+    int show_stats                  = 0;                //1 to print run statistics on stderr (--stats)
+    const char* reject_file_name    = NULL;             //Bad lines are written here instead of stopping (--rejects)
+    double max_reject_rate          = -1.0;             //Share of rejected lines that stops the run (--max-reject-rate)
 
-    FILE *file1;    //file1 for reading
-    FILE *file2;    //file2 for writing
+    //Optional flags after the options.
+    for (int i = 4; i < argc; i++) {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            num_of_threads = atoi(argv[++i]);
 
-    //Function for opening file with specific mode
-    file1 = open_file(input_file_name, "r");
-    file2 = open_file(output_file_name, "w");
+            //Throwing an error, if thread count isn't a positive number.
+            if (num_of_threads <= 0) {
+                puts("Number of threads (-j) has to be at least 1 :p\n");
+                exit(1);
+            }
+        } else if (strcmp(argv[i], "--out-buffer") == 0 && i + 1 < argc) {
+            output_buffer_size = atol(argv[++i]);
 
-    // Allocating memory for a line of text file(Max = 150).
-    char* file_line;
-    file_line = allocate_memory_for_line(file1, file2);
+            //Throwing an error, if buffer size isn't a positive number.
+            if (output_buffer_size <= 0) {
+                puts("Output buffer size (--out-buffer) has to be at least 1 byte :p\n");
+                exit(1);
+            }
+        } else if (strcmp(argv[i], "--top") == 0 && i + 1 < argc) {
+            char *end;
+            long value = strtol(argv[++i], &end, 10);
 
-    Domestic        *domestic_students;
-    International   *international_students;
+            //Throwing an error, if N isn't a whole number from 1 to INT_MAX.
+            if (*argv[i] == '\0' || *end != '\0' || value < 1 || value > INT_MAX) {
+                printf("Number of top students (--top) has to be a whole number from 1 to %d :p\n\n", INT_MAX);
+                exit(1);
+            }
+            top = (int)value;
+        } else if (strcmp(argv[i], "--snapshot") == 0 && i + 1 < argc) {
+            snapshot_file_name = argv[++i];
+        } else if (strcmp(argv[i], "--rejects") == 0 && i + 1 < argc) {
+            reject_file_name = argv[++i];
+        } else if (strcmp(argv[i], "--max-reject-rate") == 0 && i + 1 < argc) {
+            max_reject_rate = atof(argv[++i]);
 
-    // Allocating memory for number of students of both domestic and international(Max = 150).
-    allocate_memory_for_students(&domestic_students, &international_students);
+            //Throwing an error, if the rate isn't between 0 and 1.
+            if (!(max_reject_rate >= 0.0 && max_reject_rate <= 1.0)) {
+                puts("Reject rate (--max-reject-rate) has to be between 0 and 1 :p\n");
+                exit(1);
+            }
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            show_stats = 1;
+        } else if (strcmp(argv[i], "--append-only") == 0) {
+            append_only = 1;
+        } else if (strcmp(argv[i], "--also") == 0 && i + 2 < argc) {
 
-    int domestic_students_count      = 0;
-    int international_students_count = 0;
-    int max_student                  = MAX_STUDENT;
+            //Throwing an error, if there are too many outputs.
+            if (num_of_outputs == MAX_BATCH) {
+                printf("At most %d outputs in one run :p\n\n", MAX_BATCH);
+                exit(1);
+            }
+            output_file_names[num_of_outputs] = argv[++i];
+            query_specs[num_of_outputs]       = argv[++i];
+            num_of_outputs++;
+        } else if (strcmp(argv[i], "--stream") == 0) {
+            stream_mode = 1;
+        } else {
+            printf("Unknown argument: %s :p\n", argv[i]);
+            exit(1);
+        }
+    }
 
-    //Reading file line by line until the end of the file.
-    while (fgets(file_line, MAX_LINE_LENGTH, file1) != NULL) {
+    //Throwing an error, if there is a reject rate without a reject file.
+    if (max_reject_rate >= 0.0 && reject_file_name == NULL) {
+        puts("--max-reject-rate only works with --rejects :p\n");
+        exit(1);
+    }
 
-        //Parsing function
-        parse_line_of_file(file_line, &domestic_students[domestic_students_count],
-            &international_students[international_students_count]);
+    //Timing starts after the arguments are read.
+    RunStats stats;
+    stats_start(&stats, show_stats);
 
-        //If domestic student data is valid, increase the count of domestic student
-        if(validate_domestic(&domestic_students[domestic_students_count])) {
-            domestic_students_count++;
-           }
+    //Compiling every option or query spec once, before reading anything.
+    Query queries[MAX_BATCH];
+    for (int i = 0; i < num_of_outputs; i++) {
+        compile_query(query_specs[i], &queries[i]);
+        queries[i].sort_threads = num_of_threads;
 
-        //If domestic student is more than allocated memory, reallocate memory.
-        reallocate_domestic(&domestic_students, domestic_students_count, &max_student);
+        //--top N is "order by gpa desc limit N" (Keeps "asc" and a smaller limit of the query).
+        if (top != NO_LIMIT) {
+            if (queries[i].order != ORDER_GPA_ASC) {
+                queries[i].order = ORDER_GPA_DESC;
+            }
+            if (queries[i].limit == NO_LIMIT || queries[i].limit > top) {
+                queries[i].limit = top;
+            }
+        }
+    }
+
+    //Streaming mode writes while reading, so it only has one output.
+    if (stream_mode && num_of_outputs > 1) {
+        puts("--stream can't be used with --also :( \n");
+        exit(1);
+    }
+
+    //Throwing an error, if two outputs (Or an output and the reject file) would be written to the same file.
+    for (int i = 0; i < num_of_outputs; i++) {
+        for (int j = i + 1; j <= num_of_outputs; j++) {
+            const char *other = j < num_of_outputs ? output_file_names[j] : reject_file_name;
+
+            if (other != NULL && strcmp(output_file_names[i], other) == 0) {
+                printf("Output file %s is given more than once :(\n\n", other);
+                exit(1);
+            }
+        }
+    }
+
+    FILE *file1;                    //file1 for reading
+    FILE *file2[MAX_BATCH];         //file2 for writing (One for each output)
+    FILE *file3 = NULL;             //file3 for writing rejected lines (--rejects)
+
+    //Function for opening file with specific mode
+    file1 = open_file(input_file_name, "r");
+
+    //Students are formatted into a big buffer per output and written with few write() calls.
+    OutputWriter writers[MAX_BATCH];
+    for (int i = 0; i < num_of_outputs; i++) {
+        file2[i] = open_file(output_file_names[i], "w");
+        writer_open(&writers[i], file2[i], output_buffer_size);
+    }
+
+    //Bad lines go to the reject file instead of stopping the run (NULL keeps the messages and the exit).
+    RejectLog rejects;
+    RejectLog *reject_log = NULL;
+    if (reject_file_name != NULL) {
+        file3 = open_file(reject_file_name, "w");
+        reject_open(&rejects, file3, max_reject_rate >= 0.0 ? max_reject_rate : REJECT_DEFAULT_MAX_RATE);
+        reject_log = &rejects;
+    }
 
-        //If international student data is valid, increase the count of international student
-        if(validate_international(&international_students[international_students_count])) {
-            international_students_count++;
+    //Memory-mapping the input file (Buffered reads if it's a pipe or in streaming mode).
+    InputReader reader;
+    if (stream_mode) {
+        input_open_buffered(&reader, file1);
+    } else {
+        input_open(&reader, file1);
+    }
+    stats_end_stage(&stats, "open");
+
+    //Streaming mode writes matches while reading. Queries without "order by" work one student at a time,
+    //queries ordered by gpa need a limit so only the best N students are kept.
+    if (stream_mode) {
+        int by_gpa = queries[0].order == ORDER_GPA_DESC || queries[0].order == ORDER_GPA_ASC;
+
+        if (!by_gpa) {
+            stream_filter(&reader, &writers[0], &queries[0], stats.results, reject_log);
+        } else if (queries[0].limit != NO_LIMIT) {
+            stream_top(&reader, &writers[0], &queries[0], stats.results, reject_log);
+        } else {
+            puts("--stream only works with options 1 ~ 3, --top N or queries without order by :( \n");
         }
+        stats_end_stage(&stats, "stream");
+        input_close(&reader);
+        writer_close(&writers[0]);
+        fclose(file1);
+        fclose(file2[0]);
+        close_rejects(reject_log, file3);
+        stats.output_bytes = writers[0].bytes_written;
+        stats_end_stage(&stats, "close");
+        stats_print(&stats);
+        return 0;
+    }
 
-        //If the number of international student is more than allocated memory, reallocate memory.
-        reallocate_international(&international_students, international_students_count, &max_student);
-    }
-
-    //For command line argument
-    switch(options) {
-        case 1:
-            domestic_with_good_GPA(file2, domestic_students, domestic_students_count);
-            break;
-        case 2:
-            internation_with_good_GPA_and_toefl(file2, international_students, international_students_count);
-            break;
-        case 3:
-            all_student_with_good_GPA(file2, domestic_students, international_students,
-                domestic_students_count, international_students_count);
-            break;
-        case 4:
-            fprintf_sorted_gpa(file2, domestic_students, international_students, domestic_students_count,
-                international_students_count);
-            break;
-        default:
-            puts("No options available :( \n");
-            break;
-    }
-
-    //Freeing all allocated memory
-    free_all_allocate_memory(domestic_students, international_students, domestic_students_count,
-        international_students_count, file_line);
+    //Domestic and international students in one columnar table (Not one array per status, so a roster of only
+    //one status doesn't leave an empty array behind).
+    StudentTable students;
+    Snapshot snapshot;
+    const StudentTable *table = &students;
+
+    //Reading file line by line until the end of the file. Lines are parsed in place, without copying.
+    //With -j N, the file is split into N chunks parsed at the same time (Same table as one thread).
+    //With a snapshot of the same input, nothing is parsed (Only appended lines, with --append-only).
+    //With --rejects, every line is parsed (Lines in a snapshot wouldn't be written to the reject file again).
+    if (snapshot_file_name != NULL && reject_log == NULL) {
+        table = snapshot_ingest(&snapshot, snapshot_file_name, &reader, file1, &students, num_of_threads,
+            append_only);
+    } else {
+        //Sized from the input (Size of a pipe isn't known, so it starts small and doubles), shrunk once it's full.
+        table_init_for_input(&students, reader.mapped ? reader.size : 0);
+        ingest_parallel(&reader, &students, num_of_threads, reject_log);
+        table_shrink_to_fit(&students);
+    }
+    input_close(&reader);
+    close_rejects(reject_log, file3);
+    stats_end_stage(&stats, "ingest");
+
+    //Scanning, ordering and writing the students each option or query selects (One scan for a batch)
+    if (num_of_outputs == 1) {
+        query_run(&queries[0], table, &writers[0]);
+    } else {
+        query_run_batch(queries, num_of_outputs, table, writers);
+    }
+    stats_end_stage(&stats, "query");
+
+    //Freeing all allocated memory (Writing what's left in the output buffers first)
+    for (int i = 0; i < num_of_outputs; i++) {
+        writer_close(&writers[i]);
+        fclose(file2[i]);
+        stats.output_bytes += writers[i].bytes_written;
+    }
+    stats_end_stage(&stats, "flush");
+    stats_add_table(&stats, table);
+    if (table != &students) {
+        snapshot_close(&snapshot);
+    } else {
+        table_free(&students);
+    }
 
     //File close
     fclose(file1);
-    fclose(file2);
+    stats_end_stage(&stats, "free");
+    stats_print(&stats);
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,204 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: psort.c has implemented functions for the parallel sort by gpa.
+*		   parallel_sort_indices_by_gpa() Sorting parts on their own threads, then merging key ranges in parallel.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "psort.h"
+#include "topk.h"
+
+typedef struct {                    //Work of one thread
+    const StudentTable *table;      //Table the indices point into
+    unsigned int *indices;          //Selected students (Whole array)
+    unsigned long long *keys;       //Sort key of each position of indices, once its part is sorted
+    const int *bounds;              //Part p is [bounds[p], bounds[p + 1])
+    int num_of_parts;               //Number of parts
+    int part;                       //Part this thread sorts
+    int descending;                 //1 for highest gpa first
+    const int *range_starts;        //range_starts[p] = first position of this thread's key range in part p
+    const int *range_ends;          //range_ends[p] = one past the last position of the range in part p
+    unsigned int *output;           //Where the merged range goes
+} SortWork;
+
+//Function to compare two keys for qsort().
+static int compare_keys(const void *first, const void *second) {
+	unsigned long long a = *(const unsigned long long *)first;
+	unsigned long long b = *(const unsigned long long *)second;
+	return (a > b) - (a < b);
+}
+
+//Function run by each thread: sorts its part and makes the key of each position.
+static void *sort_part(void *argument) {
+	SortWork *work = argument;
+	int start      = work->bounds[work->part];
+	int end        = work->bounds[work->part + 1];
+
+	table_sort_indices_by_gpa(work->table, work->indices + start, end - start, work->descending);
+	for (int i = start; i < end; i++) {
+		unsigned int index = work->indices[i];
+		work->keys[i] = topk_key(work->table->gpa[index], work->table->status[index], index, work->descending);
+	}
+	return NULL;
+}
+
+//Function run by each thread: merges its key range of every part (Smallest key first, with a small heap).
+static void *merge_range(void *argument) {
+	SortWork *work = argument;
+	int heap[MAX_SORT_THREADS];     //Parts with students left, smallest next key on top
+	int next[MAX_SORT_THREADS];     //Next position of each part
+	int heap_size = 0;
+
+	for (int p = 0; p < work->num_of_parts; p++) {
+		next[p] = work->range_starts[p];
+		if (next[p] < work->range_ends[p]) {
+			int position = heap_size++;
+			while (position > 0 && work->keys[next[heap[(position - 1) / 2]]] > work->keys[next[p]]) {
+				heap[position] = heap[(position - 1) / 2];
+				position = (position - 1) / 2;
+			}
+			heap[position] = p;
+		}
+	}
+
+	unsigned int *output = work->output;
+	while (heap_size > 0) {
+		int part = heap[0];
+		*output++ = work->indices[next[part]++];
+
+		//Part is done: the last part takes its place on top.
+		if (next[part] == work->range_ends[part]) {
+			part = heap[--heap_size];
+			if (heap_size == 0) {
+				break;
+			}
+		}
+
+		//Moving the top part down to where its next key belongs.
+		unsigned long long key = work->keys[next[part]];
+		int position = 0;
+		while (2 * position + 1 < heap_size) {
+			int child = 2 * position + 1;
+			if (child + 1 < heap_size && work->keys[next[heap[child + 1]]] < work->keys[next[heap[child]]]) {
+				child++;
+			}
+			if (work->keys[next[heap[child]]] >= key) {
+				break;
+			}
+			heap[position] = heap[child];
+			position = child;
+		}
+		heap[position] = part;
+	}
+	return NULL;
+}
+
+//Function to find the first position in [start, end) of sorted keys with a key >= key.
+static int lower_bound(const unsigned long long *keys, int start, int end, unsigned long long key) {
+	while (start < end) {
+		int middle = start + (end - start) / 2;
+		if (keys[middle] < key) {
+			start = middle + 1;
+		} else {
+			end = middle;
+		}
+	}
+	return start;
+}
+
+//Function to run one pthread per work item and wait for all of them.
+static void run_threads(void *(*function)(void *), SortWork *work, int num_of_threads) {
+	pthread_t threads[MAX_SORT_THREADS];
+
+	for (int t = 0; t < num_of_threads; t++) {
+		if (pthread_create(&threads[t], NULL, function, &work[t]) != 0) {
+			puts("Creating sort thread failed :/\n");
+			exit(1);
+		}
+	}
+	for (int t = 0; t < num_of_threads; t++) {
+		pthread_join(threads[t], NULL);
+	}
+}
+
+//Function to sort selected students by gpa with up to num_of_threads threads.
+void parallel_sort_indices_by_gpa(const StudentTable *table, unsigned int *indices, int num_of_selected,
+	int descending, int num_of_threads) {
+	if (num_of_threads > num_of_selected / MIN_SORT_PART) {
+		num_of_threads = num_of_selected / MIN_SORT_PART;
+	}
+	if (num_of_threads > MAX_SORT_THREADS) {
+		num_of_threads = MAX_SORT_THREADS;
+	}
+	if (num_of_threads <= 1) {
+		table_sort_indices_by_gpa(table, indices, num_of_selected, descending);
+		return;
+	}
+
+	int num_of_parts          = num_of_threads;
+	int bounds[MAX_SORT_THREADS + 1];
+	int *positions            = malloc((size_t)num_of_parts * (num_of_threads + 1) * sizeof(int));
+	unsigned long long *keys  = malloc((size_t)num_of_selected * sizeof(unsigned long long));
+	unsigned int *output      = malloc((size_t)num_of_selected * sizeof(unsigned int));
+	SortWork *work            = calloc(num_of_threads, sizeof(SortWork));
+
+	//Throwing an error, if memory allocation failed.
+	if (positions == NULL || keys == NULL || output == NULL || work == NULL) {
+		puts("Memory allocation for sorting failed :(\n");
+		exit(1);
+	}
+
+	//Sorting equal parts (Indices stay in table order inside each part, so ties keep their order).
+	for (int p = 0; p <= num_of_parts; p++) {
+		bounds[p] = (int)((long long)num_of_selected * p / num_of_parts);
+	}
+	for (int t = 0; t < num_of_threads; t++) {
+		work[t] = (SortWork){table, indices, keys, bounds, num_of_parts, t, descending, NULL, NULL, NULL};
+	}
+	run_threads(sort_part, work, num_of_threads);
+
+	//Splitters: num_of_threads evenly spaced keys from each sorted part, sorted, then every num_of_threads-th one.
+	unsigned long long samples[MAX_SORT_THREADS * MAX_SORT_THREADS];
+	int num_of_samples = 0;
+	for (int p = 0; p < num_of_parts; p++) {
+		int length = bounds[p + 1] - bounds[p];
+		for (int s = 0; s < num_of_threads; s++) {
+			samples[num_of_samples++] = keys[bounds[p] + (int)((long long)length * s / num_of_threads)];
+		}
+	}
+	qsort(samples, num_of_samples, sizeof(unsigned long long), compare_keys);
+
+	//positions[t * num_of_parts + p] = where key range t starts in part p (Range t ends where t + 1 starts).
+	for (int p = 0; p < num_of_parts; p++) {
+		positions[p] = bounds[p];
+		positions[num_of_threads * num_of_parts + p] = bounds[p + 1];
+	}
+	for (int t = 1; t < num_of_threads; t++) {
+		unsigned long long splitter = samples[t * num_of_samples / num_of_threads];
+		for (int p = 0; p < num_of_parts; p++) {
+			positions[t * num_of_parts + p] = lower_bound(keys, bounds[p], bounds[p + 1], splitter);
+		}
+	}
+
+	//Each range starts in the output after every smaller key, so threads write without overlapping.
+	int output_start = 0;
+	for (int t = 0; t < num_of_threads; t++) {
+		work[t].range_starts = positions + t * num_of_parts;
+		work[t].range_ends   = positions + (t + 1) * num_of_parts;
+		work[t].output       = output + output_start;
+		for (int p = 0; p < num_of_parts; p++) {
+			output_start += work[t].range_ends[p] - work[t].range_starts[p];
+		}
+	}
+	run_threads(merge_range, work, num_of_threads);
+
+	memcpy(indices, output, (size_t)num_of_selected * sizeof(unsigned int));
+	free(positions);
+	free(keys);
+	free(output);
+	free(work);
+}
@@ -0,0 +1,22 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: Has the parallel sort by gpa (Option 4 with -j N) and its function prototypes.
+*          Each thread sorts one part of the students. Then the sorted parts are cut into key ranges and each thread
+*          merges one range (k-way), so the merge runs in parallel too. Output is the same as
+*          table_sort_indices_by_gpa(), ties included.
+*/
+#ifndef PSORT_H //Checking if PSORT_H is not defined
+#define PSORT_H
+
+#include "table.h"
+
+#define MIN_SORT_PART 65536 //Fewest students given to one sorting thread, so small sorts stay on one thread.
+#define MAX_SORT_THREADS 64 //Most threads used for one sort.
+
+//Function to sort selected students (indices in table order) by gpa with up to num_of_threads threads
+//Falls back to table_sort_indices_by_gpa() for one thread or few students.
+void parallel_sort_indices_by_gpa(const StudentTable *table, unsigned int *indices, int num_of_selected,
+    int descending, int num_of_threads);
+
+#endif // Ending #ifndef block
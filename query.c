@@ -0,0 +1,378 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: query.c has implemented functions for the query spec.
+*		   query_preset() Setting a query to option 1, 2, 3 or 4.
+*		   query_parse() Compiling a query spec into a filter, an order and a limit.
+*		   query_compile() Compiling an option (1 ~ 4) or a query spec (Shared by the command line and the server).
+*		   query_run() Writing the students a query selects, in its order.
+*		   query_run_batch() Writing several queries into their own outputs with one scan.
+*/
+
+#define _POSIX_C_SOURCE 200809L //For strcasecmp()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <limits.h>
+#include <ctype.h>
+#include "query.h"
+#include "input.h"
+#include "psort.h"
+
+#define MAX_TOKEN_LENGTH 32 //Longest word, number or operator in a query spec.
+#define TOPK_MIN_RATIO 4 //A limit up to 1/4 of the selected students uses the top N heap instead of a full sort.
+
+typedef struct {            //Reading position in a query spec
+    const char *current;    //Next character to read
+    char token[MAX_TOKEN_LENGTH]; //Last token read ("" at the end of the spec)
+} QueryLexer;
+
+//Function to set a query to select every student, in input order.
+static void query_select_all(Query *query) {
+	query->filter       = (ScanFilter){INT_MIN, INT_MAX, INT_MIN, INT_MAX, 1, 1};
+	query->order        = ORDER_INPUT;
+	query->limit        = NO_LIMIT;
+	query->show_toefl   = 1;
+	query->sort_threads = 1;
+}
+
+//Function to set query to option 1, 2, 3 or 4.
+int query_preset(int option, Query *query) {
+	query_select_all(query);
+
+	switch (option) {
+		case 1:
+			//"status=D and gpa>3.9"
+			query->filter.gpa_min       = gpa_from_thousandths(3900) + 1;
+			query->filter.international = 0;
+			return 1;
+		case 2:
+			//"status=I and gpa>3.9 and toefl>=70"
+			query->filter.gpa_min   = gpa_from_thousandths(3900) + 1;
+			query->filter.toefl_min = 70;
+			query->filter.domestic  = 0;
+			return 1;
+		case 3:
+			//"gpa>3.9 and toefl>=70", written as 1st domestic, 1st international, 2nd domestic, ...
+			query->filter.gpa_min   = gpa_from_thousandths(3900) + 1;
+			query->filter.toefl_min = 70;
+			query->order            = ORDER_INTERLEAVED;
+			return 1;
+		case 4:
+			//"order by gpa desc", without TOEFL
+			query->order      = ORDER_GPA_DESC;
+			query->show_toefl = 0;
+			return 1;
+		default:
+			return 0;
+	}
+}
+
+//Function to read the next token: a word, a number or an operator.
+static void next_token(QueryLexer *lexer) {
+	int length = 0;
+
+	while (isspace((unsigned char)*lexer->current)) {
+		lexer->current++;
+	}
+
+	if (isalpha((unsigned char)*lexer->current)) {
+		while (isalpha((unsigned char)lexer->current[length]) || lexer->current[length] == '_') {
+			length++;
+		}
+	} else if (isdigit((unsigned char)*lexer->current) || *lexer->current == '.' || *lexer->current == '+' ||
+		*lexer->current == '-') {
+		while (isdigit((unsigned char)lexer->current[length]) || lexer->current[length] == '.' ||
+			lexer->current[length] == '+' || lexer->current[length] == '-') {
+			length++;
+		}
+	} else if (strchr("<>=!", *lexer->current) != NULL && *lexer->current != '\0') {
+		while (lexer->current[length] != '\0' && strchr("<>=!", lexer->current[length]) != NULL) {
+			length++;
+		}
+	} else if (*lexer->current != '\0') {
+		length = 1;
+	}
+
+	//Longer tokens are cut. They can't match anything, so they still end up as an error.
+	int copy_length = length < MAX_TOKEN_LENGTH - 1 ? length : MAX_TOKEN_LENGTH - 1;
+	memcpy(lexer->token, lexer->current, copy_length);
+	lexer->token[copy_length] = '\0';
+	lexer->current += length;
+}
+
+//Function to check if the current token is the given word (Case doesn't matter).
+static int token_is(const QueryLexer *lexer, const char *word) {
+	return strcasecmp(lexer->token, word) == 0;
+}
+
+//Function to narrow an inclusive range [*min, *max] with "op value". Returns 0 if op isn't a comparison.
+static int narrow_range(const char *op, int value, int *min, int *max) {
+	if (strcmp(op, ">") == 0) {
+		if (value == INT_MAX) {
+			*min = INT_MAX;
+			*max = INT_MIN;
+		} else if (value + 1 > *min) {
+			*min = value + 1;
+		}
+	} else if (strcmp(op, ">=") == 0) {
+		if (value > *min) {
+			*min = value;
+		}
+	} else if (strcmp(op, "<") == 0) {
+		if (value == INT_MIN) {
+			*min = INT_MAX;
+			*max = INT_MIN;
+		} else if (value - 1 < *max) {
+			*max = value - 1;
+		}
+	} else if (strcmp(op, "<=") == 0) {
+		if (value < *max) {
+			*max = value;
+		}
+	} else if (strcmp(op, "=") == 0 || strcmp(op, "==") == 0) {
+		if (value > *min) {
+			*min = value;
+		}
+		if (value < *max) {
+			*max = value;
+		}
+	} else {
+		return 0;
+	}
+	return 1;
+}
+
+//Function to compile one condition ("gpa>3.5", "toefl >= 80", "status=I"). Lexer is on the field name.
+static int parse_condition(QueryLexer *lexer, Query *query, char *error, size_t error_size) {
+	char field[MAX_TOKEN_LENGTH];
+	char op[MAX_TOKEN_LENGTH];
+
+	strcpy(field, lexer->token);
+	next_token(lexer);
+	strcpy(op, lexer->token);
+	next_token(lexer);
+	Slice value = {lexer->token, strlen(lexer->token)};
+
+	if (strcasecmp(field, "gpa") == 0) {
+		int gpa;
+		if (!parse_gpa(value, &gpa)) {
+			snprintf(error, error_size, "GPA has to be a number, not \"%s\"", lexer->token);
+			return 0;
+		}
+		if (!narrow_range(op, gpa, &query->filter.gpa_min, &query->filter.gpa_max)) {
+			snprintf(error, error_size, "Unknown comparison \"%s\" for gpa", op);
+			return 0;
+		}
+	} else if (strcasecmp(field, "toefl") == 0) {
+		int toefl;
+		if (!parse_toefl(value, &toefl)) {
+			snprintf(error, error_size, "TOEFL has to be a whole number, not \"%s\"", lexer->token);
+			return 0;
+		}
+		if (!narrow_range(op, toefl, &query->filter.toefl_min, &query->filter.toefl_max)) {
+			snprintf(error, error_size, "Unknown comparison \"%s\" for toefl", op);
+			return 0;
+		}
+	} else if (strcasecmp(field, "status") == 0) {
+		int is_domestic = token_is(lexer, "D");
+
+		if (!is_domestic && !token_is(lexer, "I")) {
+			snprintf(error, error_size, "Status has to be D or I, not \"%s\"", lexer->token);
+			return 0;
+		}
+		if (strcmp(op, "=") == 0 || strcmp(op, "==") == 0) {
+			query->filter.domestic      &= is_domestic;
+			query->filter.international &= !is_domestic;
+		} else if (strcmp(op, "!=") == 0) {
+			query->filter.domestic      &= !is_domestic;
+			query->filter.international &= is_domestic;
+		} else {
+			snprintf(error, error_size, "Unknown comparison \"%s\" for status", op);
+			return 0;
+		}
+	} else {
+		snprintf(error, error_size, "Unknown field \"%s\" (Use gpa, toefl or status)", field);
+		return 0;
+	}
+	next_token(lexer);
+	return 1;
+}
+
+//Function to compile a query spec.
+int query_parse(const char *spec, Query *query, char *error, size_t error_size) {
+	QueryLexer lexer = {spec, ""};
+
+	query_select_all(query);
+	next_token(&lexer);
+
+	//Conditions joined with "and".
+	if (lexer.token[0] != '\0' && !token_is(&lexer, "order") && !token_is(&lexer, "limit")) {
+		if (!parse_condition(&lexer, query, error, error_size)) {
+			return 0;
+		}
+		while (token_is(&lexer, "and")) {
+			next_token(&lexer);
+			if (!parse_condition(&lexer, query, error, error_size)) {
+				return 0;
+			}
+		}
+	}
+
+	//"order by gpa [desc|asc]"
+	if (token_is(&lexer, "order")) {
+		next_token(&lexer);
+		if (!token_is(&lexer, "by")) {
+			snprintf(error, error_size, "Expected \"by\" after \"order\", not \"%s\"", lexer.token);
+			return 0;
+		}
+		next_token(&lexer);
+		if (!token_is(&lexer, "gpa")) {
+			snprintf(error, error_size, "Only \"order by gpa\" is supported, not \"%s\"", lexer.token);
+			return 0;
+		}
+		next_token(&lexer);
+		query->order = ORDER_GPA_DESC;
+		if (token_is(&lexer, "asc")) {
+			query->order = ORDER_GPA_ASC;
+			next_token(&lexer);
+		} else if (token_is(&lexer, "desc")) {
+			next_token(&lexer);
+		}
+	}
+
+	//"limit N"
+	if (token_is(&lexer, "limit")) {
+		char *end;
+		next_token(&lexer);
+		long limit = strtol(lexer.token, &end, 10);
+
+		//Throwing an error, if limit isn't a whole number from 1 to INT_MAX.
+		if (lexer.token[0] == '\0' || *end != '\0' || limit < 1 || limit > INT_MAX) {
+			snprintf(error, error_size, "Limit has to be a whole number from 1 to %d, not \"%s\"", INT_MAX,
+				lexer.token);
+			return 0;
+		}
+		query->limit = (int)limit;
+		next_token(&lexer);
+	}
+
+	//Throwing an error, if anything is left over.
+	if (lexer.token[0] != '\0') {
+		snprintf(error, error_size, "Unexpected \"%s\" in query", lexer.token);
+		return 0;
+	}
+	return 1;
+}
+
+//Function to compile an option or a query spec. A spec starting with a digit has to be one whole option
+//(1 ~ 4), so "4 limit 5" or "1abc" is an error instead of running option 4 or 1.
+int query_compile(const char *spec, Query *query, char *error, size_t error_size) {
+	if (spec[0] >= '0' && spec[0] <= '9') {
+		char *end;
+		long option = strtol(spec, &end, 10);
+
+		if (*end != '\0' || option < 1 || option > 4 || !query_preset((int)option, query)) {
+			snprintf(error, error_size, "No option %.64s", spec);
+			return 0;
+		}
+		return 1;
+	}
+	return query_parse(spec, query, error, error_size);
+}
+
+//Function to order the selected students (indices in table order) and write them, up to the query limit.
+static void write_selected(const Query *query, const StudentTable *table, OutputWriter *writer,
+	unsigned int *indices, int num_of_selected) {
+	int by_gpa = query->order == ORDER_GPA_DESC || query->order == ORDER_GPA_ASC;
+
+	if (query->order == ORDER_INTERLEAVED) {
+		table_interleave_indices(table, indices, num_of_selected);
+	} else if (by_gpa && query->limit != NO_LIMIT && query->limit <= num_of_selected / TOPK_MIN_RATIO) {
+		//Few students wanted: keeping the best ones in a heap is cheaper than sorting everyone.
+		num_of_selected = table_top_indices_by_gpa(table, indices, num_of_selected, query->limit,
+			query->order == ORDER_GPA_DESC);
+	} else if (by_gpa) {
+		parallel_sort_indices_by_gpa(table, indices, num_of_selected, query->order == ORDER_GPA_DESC,
+			query->sort_threads);
+	}
+
+	if (query->limit != NO_LIMIT && query->limit < num_of_selected) {
+		num_of_selected = query->limit;
+	}
+	for (int i = 0; i < num_of_selected; i++) {
+		table_write_student(writer, table, indices[i], query->show_toefl);
+	}
+}
+
+//Function to check if the table's gpa order (From a snapshot) can be used instead of sorting.
+static int uses_gpa_order(const Query *query, const StudentTable *table) {
+	return query->order == ORDER_GPA_DESC && table->gpa_order != NULL;
+}
+
+//Function to write the students the query selects by walking the gpa order, so nothing is sorted.
+static void write_in_gpa_order(const Query *query, const StudentTable *table, OutputWriter *writer) {
+	long num_of_written = 0;
+
+	for (int i = 0; i < table->count && (query->limit == NO_LIMIT || num_of_written < query->limit); i++) {
+		unsigned int index = table->gpa_order[i];
+
+		if (scan_matches(&query->filter, table->gpa[index], table->toefl[index], table->status[index])) {
+			table_write_student(writer, table, index, query->show_toefl);
+			num_of_written++;
+		}
+	}
+}
+
+//Function to write the students the query selects, in its order.
+void query_run(const Query *query, const StudentTable *table, OutputWriter *writer) {
+	if (uses_gpa_order(query, table)) {
+		write_in_gpa_order(query, table, writer);
+		return;
+	}
+
+	unsigned int *indices = table_allocate_indices(table);
+	int num_of_selected   = scan_select(table, &query->filter, indices);
+
+	write_selected(query, table, writer, indices, num_of_selected);
+	free(indices);
+}
+
+//Function to write the students each query selects into its own writer, with one scan for all of them.
+void query_run_batch(const Query queries[], int num_of_queries, const StudentTable *table, OutputWriter writers[]) {
+	ScanFilter *filters     = calloc(num_of_queries, sizeof(ScanFilter));
+	unsigned int **indices  = malloc(num_of_queries * sizeof(unsigned int*));
+	int *counts             = malloc(num_of_queries * sizeof(int));
+	int num_of_scanned      = 0;
+
+	//Throwing an error, if memory allocation fails.
+	if (filters == NULL || indices == NULL || counts == NULL) {
+		puts("Failed to allocate memory for the batch :( \n");
+		exit(1);
+	}
+
+	//Queries that can walk the gpa order don't need the scan.
+	for (int i = 0; i < num_of_queries; i++) {
+		if (!uses_gpa_order(&queries[i], table)) {
+			filters[num_of_scanned]   = queries[i].filter;
+			indices[num_of_scanned++] = table_allocate_indices(table);
+		}
+	}
+
+	//Filters run together block by block, so the gpa, TOEFL and status columns are read from memory once.
+	scan_select_many(table, filters, num_of_scanned, indices, counts);
+
+	for (int i = 0, scanned = 0; i < num_of_queries; i++) {
+		if (uses_gpa_order(&queries[i], table)) {
+			write_in_gpa_order(&queries[i], table, &writers[i]);
+		} else {
+			write_selected(&queries[i], table, &writers[i], indices[scanned], counts[scanned]);
+			free(indices[scanned++]);
+		}
+	}
+	free(filters);
+	free(indices);
+	free(counts);
+}
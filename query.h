@@ -0,0 +1,53 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: Has the query spec and its function prototypes.
+*          A query like "gpa>3.5 and toefl>=80 and status=I order by gpa desc limit 100" is compiled once
+*          into a ScanFilter plus an order and a limit, then run on the vectorized scan.
+*          Options 1 ~ 4 are presets of it. Several queries can run over one parsed table in one scan (Batch).
+*
+*          Conditions: gpa, toefl or status, then >, >=, <, <=, = (or ==), != (status only), then a value.
+*          TOEFL conditions only apply to international students (Domestic students have no TOEFL).
+*          Conditions are joined with "and". Then optional "order by gpa [desc|asc]" and "limit N".
+*/
+#ifndef QUERY_H //Checking if QUERY_H is not defined
+#define QUERY_H
+
+#include <stddef.h>
+#include "scan.h"
+#include "table.h"
+#include "writer.h"
+
+#define ORDER_INPUT 0 //Input order
+#define ORDER_INTERLEAVED 1 //1st domestic, 1st international, 2nd domestic, ... (Option 3)
+#define ORDER_GPA_DESC 2 //Highest gpa first (Domestic first, then input order on equal gpa)
+#define ORDER_GPA_ASC 3 //Lowest gpa first (Domestic first, then input order on equal gpa)
+
+#define NO_LIMIT -1 //Query without "limit"
+#define QUERY_ERROR_SIZE 128 //Bytes for a query error message.
+
+typedef struct {        //Compiled query
+    ScanFilter filter;  //Which students are selected
+    int order;          //ORDER_INPUT, ORDER_INTERLEAVED, ORDER_GPA_DESC or ORDER_GPA_ASC
+    int limit;          //Most students written, 1 ~ INT_MAX (NO_LIMIT for all)
+    int show_toefl;     //1 to write TOEFL of international students (0 for option 4)
+    int sort_threads;   //Threads for sorting by gpa (1 unless set, like -j N)
+} Query;
+
+//Function to set query to option 1, 2, 3 or 4. Returns 0 if there is no such option.
+int query_preset(int option, Query *query);
+
+//Function to compile a query spec. Returns 0 and writes a message into error if the spec is wrong.
+int query_parse(const char *spec, Query *query, char *error, size_t error_size);
+
+//Function to compile an option (The whole spec is 1 ~ 4) or a query spec. Returns 0 and writes a message into error
+//if it's wrong.
+int query_compile(const char *spec, Query *query, char *error, size_t error_size);
+
+//Function to write the students the query selects, in its order
+void query_run(const Query *query, const StudentTable *table, OutputWriter *writer);
+
+//Function to write the students each query selects into writers[i], in its order (One scan for every query)
+void query_run_batch(const Query queries[], int num_of_queries, const StudentTable *table, OutputWriter writers[]);
+
+#endif // Ending #ifndef block
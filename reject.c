@@ -0,0 +1,81 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: reject.c has implemented functions for the reject file of the resilient ingest (--rejects).
+*		   reject_open() Setting up the reject log.
+*		   reject_line() Writing one rejected line with its line number and reason.
+*		   reject_count_line() Counting one line read and checking the reject rate.
+*		   reject_end_of_input() Checking the reject rate of the whole input, however short it is.
+*		   reject_abort() Stopping the run when the reject rate is too high.
+*		   reject_close() Writing what's left of the reject file.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "reject.h"
+#include "table.h"
+
+#define REJECT_ENTRY_SIZE 64 //Bytes for one "<line number> <reason>\n".
+
+//Function to set up the reject log for an opened file (NULL to only count rejected lines).
+void reject_open(RejectLog *log, FILE *file, double max_rate) {
+	log->has_file          = file != NULL;
+	log->limit_line_length = 1;
+	log->max_rate          = max_rate;
+	log->lines             = 0;
+	log->rejected          = 0;
+	log->aborted           = 0;
+
+	if (file != NULL) {
+		writer_open(&log->writer, file, WRITER_BUFFER_SIZE);
+	}
+}
+
+//Function to write "<line number> <reason>" for one rejected line and count it.
+void reject_line(RejectLog *log, long line_index, int result) {
+	log->rejected++;
+
+	if (log->has_file) {
+		char entry[REJECT_ENTRY_SIZE];
+		int length = snprintf(entry, sizeof(entry), "%ld %s\n", line_index + 1, parse_result_name(result));
+		writer_write(&log->writer, entry, length);
+	}
+}
+
+//Function to count one line read. Returns 0 once the reject rate is too high.
+int reject_count_line(RejectLog *log, int result) {
+	if (result != PARSE_OK) {
+		reject_line(log, log->lines, result);
+	}
+	log->lines++;
+
+	if (result != PARSE_OK && reject_rate_exceeded(log->lines, log->rejected, log->max_rate)) {
+		log->aborted = 1;
+		return 0;
+	}
+	return 1;
+}
+
+//Function to check the reject rate once more at the end of the input, so an input shorter than REJECT_MIN_LINES
+//is checked too. A few bad lines in a short input are kept in the reject file instead of stopping the run.
+void reject_end_of_input(RejectLog *log) {
+	int no_valid_line = log->lines > 0 && log->rejected == log->lines;
+
+	if (no_valid_line || (log->rejected >= REJECT_END_MIN_REJECTED && log->rejected > log->max_rate * log->lines)) {
+		log->aborted = 1;
+	}
+}
+
+//Function to print why the run stopped and exit.
+void reject_abort(const RejectLog *log) {
+	printf("Too many rejected lines (%ld of the first %ld, more than %.1f%%) :(\n\n", log->rejected, log->lines,
+		log->max_rate * 100.0);
+	exit(1);
+}
+
+//Function to write what's left of the reject file.
+void reject_close(RejectLog *log) {
+	if (log->has_file) {
+		writer_close(&log->writer);
+	}
+}
@@ -0,0 +1,58 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: Has the reject file of the resilient ingest (--rejects) and its function prototypes.
+*          Without it, a line with a missing field stops the run. With it, every line that isn't a valid student
+*          (Missing field, TOEFL <= 0, bad gpa or status, longer than MAX_LINE_LENGTH) is written to the reject file
+*          as "<line number> <reason>" and reading goes on. Nothing is printed for it.
+*          Once REJECT_MIN_LINES lines are read, a share of rejected lines above max_rate stops the run early,
+*          so an input that is all garbage isn't read to the end. With -j N the threads parse their whole part and the
+*          same check is run over the whole input in line order when they are joined, so it stops at the same line.
+*/
+#ifndef REJECT_H //Checking if REJECT_H is not defined
+#define REJECT_H
+
+#include <stdio.h>
+#include "writer.h"
+
+#define REJECT_MIN_LINES 1000 //Lines read before the rate is checked mid-input (Shorter inputs are checked at the end).
+#define REJECT_DEFAULT_MAX_RATE 0.10 //Largest share of rejected lines if --max-reject-rate isn't given.
+#define REJECT_END_MIN_REJECTED 10 //Rejected lines a short input needs before its rate stops the run at the end.
+
+typedef struct {            //Reject file and its counters
+    OutputWriter writer;    //Reject file (Only if has_file is 1)
+    int has_file;           //0 to only count rejected lines
+    int limit_line_length;  //1 to reject lines longer than MAX_LINE_LENGTH (--rejects), 0 to parse them like the CLI
+    double max_rate;        //Largest share of rejected lines before the run stops
+    long lines;             //Lines read (Counter)
+    long rejected;          //Lines rejected (Counter)
+    int aborted;            //1 once reading stopped because of the reject rate
+} RejectLog;
+
+//Function to check if rejected lines out of lines read are too many (Only after REJECT_MIN_LINES lines)
+static inline int reject_rate_exceeded(long lines, long rejected, double max_rate) {
+    return lines >= REJECT_MIN_LINES && rejected > max_rate * lines;
+}
+
+//Function to set up the reject log for an opened file (NULL to only count rejected lines)
+void reject_open(RejectLog *log, FILE *file, double max_rate);
+
+//Function to write "<line number> <reason>" for the line at line_index (0 for the first line of the input) and count it
+void reject_line(RejectLog *log, long line_index, int result);
+
+//Function to count one line read with its PARSE_ result, writing it to the reject file if it isn't PARSE_OK
+//Returns 0 (And sets aborted) once the reject rate is too high, so the caller stops reading.
+int reject_count_line(RejectLog *log, int result);
+
+//Function to check the reject rate of every line read once the input has ended (Sets aborted if it's too high)
+//Inputs shorter than REJECT_MIN_LINES are only checked here, and only stop with at least REJECT_END_MIN_REJECTED
+//rejected lines or no valid line at all.
+void reject_end_of_input(RejectLog *log);
+
+//Function to print why the run stopped and exit (After reading stopped because of the reject rate)
+void reject_abort(const RejectLog *log);
+
+//Function to write what's left of the reject file (Doesn't close the file)
+void reject_close(RejectLog *log);
+
+#endif // Ending #ifndef block
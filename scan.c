@@ -0,0 +1,177 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: scan.c has implemented functions for the vectorized filter kernels.
+*		   scan_best_kernel() Choosing the fastest kernel this CPU can run.
+*		   scan_kernel_name() Getting the name of a kernel.
+*		   scan_select_kernel() Selecting students matching a filter with a given kernel.
+*		   scan_select() Selecting students matching a filter with the fastest kernel.
+*/
+
+#include <string.h>
+#include "scan.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SCAN_HAS_X86 1
+#else
+#define SCAN_HAS_X86 0
+#endif
+
+//Scalar kernel: one student at a time.
+static int scan_scalar(const StudentTable *table, const ScanFilter *filter, int start, int end,
+	unsigned int *indices) {
+	int num_of_selected = 0;
+
+	for (int i = start; i < end; i++) {
+		//Writing the index every time and moving on only if it matched (No branch on the filter result).
+		indices[num_of_selected] = i;
+		num_of_selected += scan_matches(filter, table->gpa[i], table->toefl[i], table->status[i]);
+	}
+	return num_of_selected;
+}
+
+#if SCAN_HAS_X86
+
+//SSE2 kernel: 4 students at a time.
+__attribute__((target("sse2")))
+static int scan_sse2(const StudentTable *table, const ScanFilter *filter, int start, int end,
+	unsigned int *indices) {
+	const __m128i gpa_min       = _mm_set1_epi32(filter->gpa_min);
+	const __m128i gpa_max       = _mm_set1_epi32(filter->gpa_max);
+	const __m128i toefl_min     = _mm_set1_epi32(filter->toefl_min);
+	const __m128i toefl_max     = _mm_set1_epi32(filter->toefl_max);
+	const __m128i domestic      = _mm_set1_epi32(filter->domestic ? 'D' : -1);
+	const __m128i international = _mm_set1_epi32(filter->international ? 'I' : -1);
+	const __m128i zero          = _mm_setzero_si128();
+	int num_of_selected = 0;
+	int i = start;
+
+	for (; i + 4 <= end; i += 4) {
+		__m128i gpa   = _mm_loadu_si128((const __m128i *)(table->gpa + i));
+		__m128i toefl = _mm_loadu_si128((const __m128i *)(table->toefl + i));
+
+		//Widening 4 status bytes to 4 ints.
+		int status_bytes;
+		memcpy(&status_bytes, table->status + i, sizeof(int));
+		__m128i status = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(status_bytes), zero), zero);
+
+		//In range means neither below the minimum nor above the maximum.
+		__m128i gpa_out   = _mm_or_si128(_mm_cmpgt_epi32(gpa_min, gpa), _mm_cmpgt_epi32(gpa, gpa_max));
+		__m128i toefl_out = _mm_or_si128(_mm_cmpgt_epi32(toefl_min, toefl), _mm_cmpgt_epi32(toefl, toefl_max));
+		__m128i is_domestic      = _mm_cmpeq_epi32(status, domestic);
+		__m128i is_international = _mm_andnot_si128(toefl_out, _mm_cmpeq_epi32(status, international));
+		__m128i selected = _mm_andnot_si128(gpa_out, _mm_or_si128(is_domestic, is_international));
+
+		int mask = _mm_movemask_ps(_mm_castsi128_ps(selected));
+		while (mask != 0) {
+			indices[num_of_selected++] = i + __builtin_ctz(mask);
+			mask &= mask - 1;
+		}
+	}
+	return num_of_selected + scan_scalar(table, filter, i, end, indices + num_of_selected);
+}
+
+//AVX2 kernel: 8 students at a time.
+__attribute__((target("avx2")))
+static int scan_avx2(const StudentTable *table, const ScanFilter *filter, int start, int end,
+	unsigned int *indices) {
+	const __m256i gpa_min       = _mm256_set1_epi32(filter->gpa_min);
+	const __m256i gpa_max       = _mm256_set1_epi32(filter->gpa_max);
+	const __m256i toefl_min     = _mm256_set1_epi32(filter->toefl_min);
+	const __m256i toefl_max     = _mm256_set1_epi32(filter->toefl_max);
+	const __m256i domestic      = _mm256_set1_epi32(filter->domestic ? 'D' : -1);
+	const __m256i international = _mm256_set1_epi32(filter->international ? 'I' : -1);
+	int num_of_selected = 0;
+	int i = start;
+
+	for (; i + 8 <= end; i += 8) {
+		__m256i gpa   = _mm256_loadu_si256((const __m256i *)(table->gpa + i));
+		__m256i toefl = _mm256_loadu_si256((const __m256i *)(table->toefl + i));
+
+		//Widening 8 status bytes to 8 ints.
+		__m256i status = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(table->status + i)));
+
+		//In range means neither below the minimum nor above the maximum.
+		__m256i gpa_out   = _mm256_or_si256(_mm256_cmpgt_epi32(gpa_min, gpa), _mm256_cmpgt_epi32(gpa, gpa_max));
+		__m256i toefl_out = _mm256_or_si256(_mm256_cmpgt_epi32(toefl_min, toefl),
+			_mm256_cmpgt_epi32(toefl, toefl_max));
+		__m256i is_domestic      = _mm256_cmpeq_epi32(status, domestic);
+		__m256i is_international = _mm256_andnot_si256(toefl_out, _mm256_cmpeq_epi32(status, international));
+		__m256i selected = _mm256_andnot_si256(gpa_out, _mm256_or_si256(is_domestic, is_international));
+
+		int mask = _mm256_movemask_ps(_mm256_castsi256_ps(selected));
+		while (mask != 0) {
+			indices[num_of_selected++] = i + __builtin_ctz(mask);
+			mask &= mask - 1;
+		}
+	}
+	return num_of_selected + scan_scalar(table, filter, i, end, indices + num_of_selected);
+}
+
+#endif
+
+//Function to get the fastest kernel this CPU can run.
+int scan_best_kernel(void) {
+#if SCAN_HAS_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		return SCAN_KERNEL_AVX2;
+	}
+	if (__builtin_cpu_supports("sse2")) {
+		return SCAN_KERNEL_SSE2;
+	}
+#endif
+	return SCAN_KERNEL_SCALAR;
+}
+
+//Function to get the name of a kernel.
+const char *scan_kernel_name(int kernel) {
+	switch (kernel) {
+		case SCAN_KERNEL_AVX2:
+			return "avx2";
+		case SCAN_KERNEL_SSE2:
+			return "sse2";
+		default:
+			return "scalar";
+	}
+}
+
+//Function to write indices of students in [start, end) matching filter, in table order.
+int scan_select_kernel(int kernel, const StudentTable *table, const ScanFilter *filter, int start, int end,
+	unsigned int *indices) {
+#if SCAN_HAS_X86
+	if (kernel == SCAN_KERNEL_AVX2) {
+		return scan_avx2(table, filter, start, end, indices);
+	}
+	if (kernel == SCAN_KERNEL_SSE2) {
+		return scan_sse2(table, filter, start, end, indices);
+	}
+#endif
+	(void)kernel;
+	return scan_scalar(table, filter, start, end, indices);
+}
+
+//Function to select students matching filter with the fastest kernel.
+int scan_select(const StudentTable *table, const ScanFilter *filter, unsigned int *indices) {
+	return scan_select_kernel(scan_best_kernel(), table, filter, 0, table->count, indices);
+}
+
+//Function to select students for several filters in one pass over the table.
+void scan_select_many(const StudentTable *table, const ScanFilter filters[], int num_of_filters,
+	unsigned int *indices[], int counts[]) {
+	int kernel = scan_best_kernel();
+
+	for (int i = 0; i < num_of_filters; i++) {
+		counts[i] = 0;
+	}
+
+	//Every filter scans a block while its gpa, TOEFL and status columns are still in cache.
+	for (int start = 0; start < table->count; start += SCAN_BLOCK_SIZE) {
+		int end = start + SCAN_BLOCK_SIZE < table->count ? start + SCAN_BLOCK_SIZE : table->count;
+
+		for (int i = 0; i < num_of_filters; i++) {
+			counts[i] += scan_select_kernel(kernel, table, &filters[i], start, end, indices[i] + counts[i]);
+		}
+	}
+}
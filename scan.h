@@ -0,0 +1,55 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: Has the vectorized filter kernels over the student table and their function prototypes.
+*          A kernel compares packed gpa, TOEFL and status columns several students at a time and writes the
+*          indices of the selected students. AVX2 (8 students) or SSE2 (4 students) is chosen at runtime,
+*          with a scalar kernel for other CPUs. Several filters can share one pass over the table.
+*/
+#ifndef SCAN_H //Checking if SCAN_H is not defined
+#define SCAN_H
+
+#include "table.h"
+
+#define SCAN_KERNEL_SCALAR 0 //One student at a time
+#define SCAN_KERNEL_SSE2 1 //4 students at a time (x86)
+#define SCAN_KERNEL_AVX2 2 //8 students at a time (x86 with AVX2)
+#define SCAN_BLOCK_SIZE 4096 //Students scanned by every filter before moving on (Columns stay in cache).
+
+typedef struct {        //Which students a scan selects (Ranges include both ends)
+    int gpa_min;        //Lowest gpa (GPA_SCALE x thousandths, like the table)
+    int gpa_max;        //Highest gpa (GPA_SCALE x thousandths, like the table)
+    int toefl_min;      //Lowest TOEFL (Only checked for international students)
+    int toefl_max;      //Highest TOEFL (Only checked for international students)
+    int domestic;       //1 to select domestic students
+    int international;  //1 to select international students
+} ScanFilter;
+
+//Function to check one student against the filter
+static inline int scan_matches(const ScanFilter *filter, int gpa, int toefl, char status) {
+    int gpa_ok   = gpa >= filter->gpa_min && gpa <= filter->gpa_max;
+    int toefl_ok = toefl >= filter->toefl_min && toefl <= filter->toefl_max;
+
+    return gpa_ok && ((status == 'D' && filter->domestic) || (status == 'I' && filter->international && toefl_ok));
+}
+
+//Function to get the fastest kernel this CPU can run
+int scan_best_kernel(void);
+
+//Function to get the name of a kernel ("scalar", "sse2" or "avx2")
+const char *scan_kernel_name(int kernel);
+
+//Function to write indices of students in [start, end) matching filter, in table order. Returns how many.
+//indices needs room for end - start students.
+int scan_select_kernel(int kernel, const StudentTable *table, const ScanFilter *filter, int start, int end,
+    unsigned int *indices);
+
+//Function to select students matching filter with the fastest kernel. Returns how many.
+int scan_select(const StudentTable *table, const ScanFilter *filter, unsigned int *indices);
+
+//Function to select students for several filters in one pass over the table, block by block.
+//indices[i] needs room for every student and gets the students matching filters[i], counts[i] of them.
+void scan_select_many(const StudentTable *table, const ScanFilter filters[], int num_of_filters,
+    unsigned int *indices[], int counts[]);
+
+#endif // Ending #ifndef block
@@ -0,0 +1,517 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: server.c has implemented functions for the query server (--serve).
+*		   server_run() Loading the roster, then answering requests on a Unix domain socket until it's stopped.
+*		   The main thread polls every open connection and queues one for a worker only once it has data, so
+*		   idle clients don't hold a worker. The worker answers the whole lines it read and hands the
+*		   connection back to be polled again.
+*		   A watcher thread checks the roster file every SERVER_POLL_MS and loads it again when it has changed.
+*		   The new roster replaces the old one at once. Requests still running on the old one finish on it,
+*		   and the last of them frees it.
+*/
+
+#define _GNU_SOURCE //For sigaction(), nanosleep(), fileno() and st_mtim
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <pthread.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "server.h"
+#include "table.h"
+#include "ingest.h"
+#include "reject.h"
+#include "query.h"
+#include "writer.h"
+
+typedef struct {            //One loaded roster
+    StudentTable table;     //Parsed roster with its gpa order (Option 4 walks it instead of sorting)
+    int users;              //Requests running on it, plus 1 while it's the current roster (Counter)
+} Roster;
+
+typedef struct Connection {             //One client connection
+    int fd;                             //Socket
+    size_t used;                        //Bytes of request read but not answered yet (No whole line)
+    struct Connection *next;            //Next connection handed back to the main thread
+    char request[SERVER_MAX_REQUEST + 1]; //Request being read
+} Connection;
+
+typedef struct {                    //Server state shared by every thread
+    const ServerConfig *config;     //Settings
+    int wake_fds[2];                //Pipe a worker writes to when it hands a connection back (Wakes poll())
+    pthread_mutex_t lock;           //Guards everything below
+    pthread_cond_t not_empty;       //Signalled when a connection is queued
+    pthread_cond_t not_full;        //Signalled when a worker takes a connection
+    Connection *queue[SERVER_QUEUE_SIZE]; //Connections with data waiting for a worker
+    int queue_head;                 //Next connection to take
+    int queued;                     //Connections in the queue
+    Connection *handed_back;        //Connections answered and waiting to be polled again
+    Roster *roster;                 //Current roster
+    struct stat loaded;             //Roster file when the current roster was loaded (Watcher thread only)
+    long requests;                  //Requests answered (Counter)
+    long reloads;                   //Times the roster was loaded again (Counter)
+} Server;
+
+typedef struct {                //Connections the main thread waits on
+    struct pollfd *fds;         //Listening socket, wake pipe, then one for each connection
+    Connection **connections;   //Connection of fds[i + 2]
+    int count;                  //Connections waited on
+    int capacity;               //Connections there is room for
+} PollSet;
+
+static volatile sig_atomic_t stop_requested = 0; //Set by SIGINT or SIGTERM.
+
+//Function to get current time in seconds.
+static double now_seconds(void) {
+	struct timespec time_now;
+	clock_gettime(CLOCK_MONOTONIC, &time_now);
+	return time_now.tv_sec + time_now.tv_nsec / 1e9;
+}
+
+//Function to stop the server on SIGINT or SIGTERM.
+static void request_stop(int signal_number) {
+	(void)signal_number;
+	stop_requested = 1;
+}
+
+//Function to parse the roster file into a new roster with its gpa order. Returns NULL if it can't be opened or
+//has too many bad lines. Bad lines are only counted (Like --rejects without a file), so one can't stop the server.
+//Long lines are parsed like the CLI does without --rejects, so the server and the CLI answer the same.
+//loaded is set to the file's size and modification time when it was opened.
+static Roster *roster_load(const char *input_file_name, int threads, struct stat *loaded) {
+	FILE *file1 = fopen(input_file_name, "r");
+
+	if (file1 == NULL || fstat(fileno(file1), loaded) != 0) {
+		if (file1 != NULL) {
+			fclose(file1);
+		}
+		return NULL;
+	}
+
+	Roster *roster = malloc(sizeof(Roster));
+
+	//Throwing an error, if memory allocation failed.
+	if (roster == NULL) {
+		puts("Memory allocation for roster failed :(\n");
+		exit(1);
+	}
+
+	double start = now_seconds();
+	InputReader reader;
+	RejectLog rejects;
+	reject_open(&rejects, NULL, REJECT_DEFAULT_MAX_RATE);
+	rejects.limit_line_length = 0;
+	input_open(&reader, file1);
+	table_init_for_input(&roster->table, reader.mapped ? reader.size : 0);
+	ingest_parallel(&reader, &roster->table, threads, &rejects);
+	reject_end_of_input(&rejects);
+	input_close(&reader);
+	fclose(file1);
+
+	if (rejects.aborted) {
+		printf("Not loading %s: too many rejected lines (%ld of the first %ld) :/\n", input_file_name,
+			rejects.rejected, rejects.lines);
+		fflush(stdout);
+		table_free(&roster->table);
+		free(roster);
+		return NULL;
+	}
+	table_shrink_to_fit(&roster->table);
+	table_build_gpa_order(&roster->table);
+
+	roster->users = 1;
+	printf("Loaded %s: %d students (%ld lines rejected) in %.3f s\n", input_file_name, roster->table.count,
+		rejects.rejected, now_seconds() - start);
+	fflush(stdout);
+	return roster;
+}
+
+//Function to check if two stats of the roster file are the same version of it.
+static int same_version(const struct stat *first, const struct stat *second) {
+	return first->st_ino == second->st_ino && first->st_size == second->st_size &&
+		first->st_mtim.tv_sec == second->st_mtim.tv_sec && first->st_mtim.tv_nsec == second->st_mtim.tv_nsec;
+}
+
+//Function to take the current roster for one request (It isn't freed until server_release()).
+static Roster *server_acquire(Server *server) {
+	pthread_mutex_lock(&server->lock);
+	Roster *roster = server->roster;
+	roster->users++;
+	server->requests++;
+	pthread_mutex_unlock(&server->lock);
+	return roster;
+}
+
+//Function to give a roster back. The last user of a replaced roster frees it.
+static void server_release(Server *server, Roster *roster) {
+	pthread_mutex_lock(&server->lock);
+	int last_user = --roster->users == 0;
+	pthread_mutex_unlock(&server->lock);
+
+	if (last_user) {
+		table_free(&roster->table);
+		free(roster);
+	}
+}
+
+//Function run by the watcher thread: loads the roster again once its file has changed and then stayed the same
+//for one poll (So a roster that is still being written isn't loaded half way).
+static void *watch_roster(void *argument) {
+	Server *server = argument;
+	struct stat previous = server->loaded;
+	struct timespec poll_time = {SERVER_POLL_MS / 1000, (SERVER_POLL_MS % 1000) * 1000000L};
+
+	while (!stop_requested) {
+		nanosleep(&poll_time, NULL);
+
+		//File can be missing for a moment while it's replaced.
+		struct stat current;
+		if (stat(server->config->input_file_name, &current) != 0) {
+			continue;
+		}
+		if (same_version(&current, &server->loaded) || !same_version(&current, &previous)) {
+			previous = current;
+			continue;
+		}
+
+		Roster *roster = roster_load(server->config->input_file_name, server->config->threads, &server->loaded);
+		previous = current;
+		if (roster == NULL) {
+			continue;
+		}
+
+		pthread_mutex_lock(&server->lock);
+		Roster *old_roster = server->roster;
+		server->roster = roster;
+		server->reloads++;
+		pthread_mutex_unlock(&server->lock);
+		server_release(server, old_roster);
+	}
+	return NULL;
+}
+
+//Function to compile a request (An option or a query spec). Returns 0 and writes a message into error if it's wrong.
+static int compile_request(const char *request, Query *query, char *error, size_t error_size) {
+	if (request[0] == '\0') {
+		snprintf(error, error_size, "Empty request");
+		return 0;
+	}
+	return query_compile(request, query, error, error_size);
+}
+
+//Function to answer one request line: "OK\n" and the students, or "ERR <message>\n", then an empty line.
+static void answer_request(Server *server, char *request, OutputWriter *writer) {
+	Query query;
+	char error[QUERY_ERROR_SIZE];
+
+	if (!compile_request(request, &query, error, sizeof(error))) {
+		writer_write(writer, "ERR ", 4);
+		writer_write(writer, error, strlen(error));
+		writer_write(writer, "\n\n", 2);
+		writer_flush(writer);
+		return;
+	}
+
+	Roster *roster = server_acquire(server);
+	writer_write(writer, "OK\n", 3);
+	query_run(&query, &roster->table, writer);
+	server_release(server, roster);
+
+	writer_write(writer, "\n", 1);
+	writer_flush(writer);
+}
+
+//Function to read what a connection has sent and answer every whole line of it.
+//Returns 0 if the connection is finished (Client closed it, a reply failed or a request is too long).
+static int serve_connection(Server *server, Connection *connection, OutputWriter *writer) {
+	ssize_t bytes_read;
+
+	do {
+		bytes_read = read(connection->fd, connection->request + connection->used,
+			SERVER_MAX_REQUEST - connection->used);
+	} while (bytes_read < 0 && errno == EINTR);
+
+	if (bytes_read <= 0) {
+		return 0;
+	}
+	connection->used += bytes_read;
+
+	//Answering each whole line, then moving what's after it to the front.
+	char *newline;
+	while (!writer->failed && (newline = memchr(connection->request, '\n', connection->used)) != NULL) {
+		size_t line_length = newline - connection->request;
+
+		*newline = '\0';
+		if (line_length > 0 && connection->request[line_length - 1] == '\r') {
+			connection->request[line_length - 1] = '\0';
+		}
+		answer_request(server, connection->request, writer);
+		connection->used -= line_length + 1;
+		memmove(connection->request, newline + 1, connection->used);
+	}
+
+	//Throwing an error, if the request doesn't fit (The rest of the connection can't be read as lines).
+	if (connection->used == SERVER_MAX_REQUEST) {
+		char error[QUERY_ERROR_SIZE];
+		int length = snprintf(error, sizeof(error), "ERR Request is longer than %d bytes\n\n",
+			SERVER_MAX_REQUEST);
+		writer_write(writer, error, length);
+		writer_flush(writer);
+		return 0;
+	}
+	return !writer->failed;
+}
+
+//Function run by each worker thread: takes connections with data from the queue and answers them.
+static void *serve_connections(void *argument) {
+	Server *server = argument;
+	OutputWriter writer;
+
+	//One reply buffer per worker, pointed at each connection it serves.
+	writer_open_fd(&writer, -1, server->config->output_buffer_size);
+
+	for (;;) {
+		pthread_mutex_lock(&server->lock);
+		while (server->queued == 0) {
+			pthread_cond_wait(&server->not_empty, &server->lock);
+		}
+		Connection *connection = server->queue[server->queue_head];
+		server->queue_head = (server->queue_head + 1) % SERVER_QUEUE_SIZE;
+		server->queued--;
+		pthread_cond_signal(&server->not_full);
+		pthread_mutex_unlock(&server->lock);
+
+		writer.fd     = connection->fd;
+		writer.failed = 0;
+		if (!serve_connection(server, connection, &writer)) {
+			close(connection->fd);
+			free(connection);
+			continue;
+		}
+
+		//Handing the connection back, so its next request is waited for by poll() instead of this worker.
+		pthread_mutex_lock(&server->lock);
+		connection->next     = server->handed_back;
+		server->handed_back = connection;
+		pthread_mutex_unlock(&server->lock);
+		//Waking poll() (A full pipe already has wake ups waiting, so that isn't an error).
+		if (write(server->wake_fds[1], "", 1) < 0 && errno != EAGAIN) {
+			puts("Waking the server failed :/\n");
+		}
+	}
+	return NULL;
+}
+
+//Function to queue a connection with data for a worker (Waits while the queue is full).
+static void queue_connection(Server *server, Connection *connection) {
+	pthread_mutex_lock(&server->lock);
+	while (server->queued == SERVER_QUEUE_SIZE) {
+		pthread_cond_wait(&server->not_full, &server->lock);
+	}
+	server->queue[(server->queue_head + server->queued) % SERVER_QUEUE_SIZE] = connection;
+	server->queued++;
+	pthread_cond_signal(&server->not_empty);
+	pthread_mutex_unlock(&server->lock);
+}
+
+//Function to wait on a connection until it sends something.
+static void poll_set_add(PollSet *polled, Connection *connection) {
+	if (polled->count == polled->capacity) {
+		polled->capacity *= 2;
+		polled->fds         = realloc(polled->fds, (polled->capacity + 2) * sizeof(struct pollfd));
+		polled->connections = realloc(polled->connections, polled->capacity * sizeof(Connection *));
+
+		//Throwing an error, if memory reallocation failed.
+		if (polled->fds == NULL || polled->connections == NULL) {
+			puts("Memory reallocation for connections failed :/ \n");
+			exit(1);
+		}
+	}
+	polled->fds[polled->count + 2] = (struct pollfd){connection->fd, POLLIN, 0};
+	polled->connections[polled->count] = connection;
+	polled->count++;
+}
+
+//Function to stop waiting on the index-th connection (The last one takes its place).
+static void poll_set_remove(PollSet *polled, int index) {
+	polled->count--;
+	polled->fds[index + 2]     = polled->fds[polled->count + 2];
+	polled->connections[index] = polled->connections[polled->count];
+}
+
+//Function to open the listening socket (A socket file left by a server that didn't stop is replaced).
+static int open_socket(const char *socket_file_name) {
+	struct sockaddr_un address;
+	struct stat socket_status;
+
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+
+	//Throwing an error, if the path doesn't fit in the address.
+	if (strlen(socket_file_name) >= sizeof(address.sun_path)) {
+		printf("Socket file name is longer than %zu bytes :(\n\n", sizeof(address.sun_path) - 1);
+		exit(1);
+	}
+	strcpy(address.sun_path, socket_file_name);
+
+	if (stat(socket_file_name, &socket_status) == 0 && S_ISSOCK(socket_status.st_mode)) {
+		unlink(socket_file_name);
+	}
+
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+	//Throwing an error, if the socket can't be opened.
+	if (fd < 0 || bind(fd, (struct sockaddr *)&address, sizeof(address)) != 0 || listen(fd, SERVER_BACKLOG) != 0) {
+		printf("Opening socket %s failed :(\n\n", socket_file_name);
+		exit(1);
+	}
+	return fd;
+}
+
+//Function to start a thread that runs forever (Blocked from SIGINT and SIGTERM, so only the main thread stops).
+static void start_thread(void *(*run)(void *), Server *server) {
+	pthread_t thread;
+	sigset_t stop_signals;
+	sigset_t old_signals;
+
+	sigemptyset(&stop_signals);
+	sigaddset(&stop_signals, SIGINT);
+	sigaddset(&stop_signals, SIGTERM);
+	pthread_sigmask(SIG_BLOCK, &stop_signals, &old_signals);
+
+	//Throwing an error, if the thread can't be started.
+	if (pthread_create(&thread, NULL, run, server) != 0) {
+		puts("Creating server thread failed :/\n");
+		exit(1);
+	}
+	pthread_detach(thread);
+	pthread_sigmask(SIG_SETMASK, &old_signals, NULL);
+}
+
+//Function to load the roster and answer requests until SIGINT or SIGTERM.
+void server_run(const ServerConfig *config) {
+	Server server;
+
+	memset(&server, 0, sizeof(server));
+	server.config = config;
+	pthread_mutex_init(&server.lock, NULL);
+	pthread_cond_init(&server.not_empty, NULL);
+	pthread_cond_init(&server.not_full, NULL);
+
+	//Throwing an error, if the wake up pipe can't be made (Non-blocking, so a worker never waits on it).
+	if (pipe(server.wake_fds) != 0 || fcntl(server.wake_fds[0], F_SETFL, O_NONBLOCK) != 0 ||
+		fcntl(server.wake_fds[1], F_SETFL, O_NONBLOCK) != 0) {
+		puts("Creating server pipe failed :/\n");
+		exit(1);
+	}
+
+	server.roster = roster_load(config->input_file_name, config->threads, &server.loaded);
+
+	//Throwing an error, if the roster can't be opened.
+	if (server.roster == NULL) {
+		printf("Can't load file %s :(\n\n", config->input_file_name);
+		exit(1);
+	}
+
+	//Stopping on SIGINT or SIGTERM. A client leaving in the middle of a reply only fails that writer (No SIGPIPE).
+	struct sigaction stop_action;
+	memset(&stop_action, 0, sizeof(stop_action));
+	stop_action.sa_handler = request_stop;
+	sigaction(SIGINT, &stop_action, NULL);
+	sigaction(SIGTERM, &stop_action, NULL);
+	signal(SIGPIPE, SIG_IGN);
+
+	int listen_fd = open_socket(config->socket_file_name);
+	for (int i = 0; i < config->workers; i++) {
+		start_thread(serve_connections, &server);
+	}
+	start_thread(watch_roster, &server);
+
+	printf("Serving %s on %s with %d workers\n", config->input_file_name, config->socket_file_name, config->workers);
+	fflush(stdout);
+
+	PollSet polled = {malloc((SERVER_QUEUE_SIZE + 2) * sizeof(struct pollfd)),
+		malloc(SERVER_QUEUE_SIZE * sizeof(Connection *)), 0, SERVER_QUEUE_SIZE};
+
+	//Throwing an error, if memory allocation failed.
+	if (polled.fds == NULL || polled.connections == NULL) {
+		puts("Memory allocation for connections failed :(\n");
+		exit(1);
+	}
+	polled.fds[0] = (struct pollfd){listen_fd, POLLIN, 0};
+	polled.fds[1] = (struct pollfd){server.wake_fds[0], POLLIN, 0};
+
+	//Waiting for new connections, requests and handed back connections a poll at a time, so a stop request is
+	//seen even if nothing happens.
+	while (!stop_requested) {
+		if (poll(polled.fds, polled.count + 2, SERVER_POLL_MS) <= 0) {
+			continue;
+		}
+		int has_new_connection = polled.fds[0].revents != 0;
+		int has_handed_back    = polled.fds[1].revents != 0;
+
+		//Queueing each connection that sent something (Or closed) for a worker. It isn't polled again until the
+		//worker hands it back. Going backwards, the connection moved into a removed slot was already checked.
+		for (int i = polled.count - 1; i >= 0; i--) {
+			if (polled.fds[i + 2].revents != 0) {
+				Connection *connection = polled.connections[i];
+				poll_set_remove(&polled, i);
+				queue_connection(&server, connection);
+			}
+		}
+
+		if (has_handed_back) {
+			//Emptying the pipe (Its bytes are only wake ups, the connections are in handed_back).
+			char wake_ups[64];
+			while (read(server.wake_fds[0], wake_ups, sizeof(wake_ups)) > 0) {
+				continue;
+			}
+
+			pthread_mutex_lock(&server.lock);
+			Connection *connection = server.handed_back;
+			server.handed_back = NULL;
+			pthread_mutex_unlock(&server.lock);
+
+			while (connection != NULL) {
+				Connection *next = connection->next;
+				poll_set_add(&polled, connection);
+				connection = next;
+			}
+		}
+
+		if (has_new_connection) {
+			int fd = accept(listen_fd, NULL, NULL);
+			if (fd < 0) {
+				continue;
+			}
+
+			Connection *connection = malloc(sizeof(Connection));
+
+			//Throwing an error, if memory allocation failed.
+			if (connection == NULL) {
+				puts("Memory allocation for connection failed :(\n");
+				exit(1);
+			}
+			connection->fd   = fd;
+			connection->used = 0;
+			poll_set_add(&polled, connection);
+		}
+	}
+
+	//Connections still open are cut when the process ends (The roster is left for the process exit to free).
+	close(listen_fd);
+	unlink(config->socket_file_name);
+
+	pthread_mutex_lock(&server.lock);
+	printf("Stopped after %ld requests and %ld reloads\n", server.requests, server.reloads);
+	pthread_mutex_unlock(&server.lock);
+}
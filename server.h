@@ -0,0 +1,36 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: Has the query server (--serve) and its function prototypes.
+*          The roster is parsed once and kept in memory with its gpa order, then queries are answered over a
+*          Unix domain socket by a pool of worker threads. The roster is loaded again when its file changes.
+*          The roster is parsed like the CLI without --rejects (Lines of any length), except that a bad line is
+*          only counted instead of stopping the server. Too many bad lines (See reject.h) keep the old roster.
+*
+*          Protocol: one request per line, an option (1 ~ 4) or a query spec like the third argument of Lab6.
+*          Reply is "OK\n" then the students, one per line like the output file, or "ERR <message>\n".
+*          Every reply ends with an empty line. A connection can send any number of requests.
+*          A worker is only given a connection once it has sent something, and hands it back after answering
+*          the whole lines it read. Idle connections wait in poll(), so any number of them can stay open.
+*/
+#ifndef SERVER_H //Checking if SERVER_H is not defined
+#define SERVER_H
+
+#define SERVER_MAX_REQUEST 1024 //Longest request line in bytes.
+#define SERVER_BACKLOG 64 //Connections waiting to be accepted.
+#define SERVER_QUEUE_SIZE 256 //Connections with a request waiting for a worker.
+#define SERVER_POLL_MS 200 //How often the roster file is checked for changes, in milliseconds.
+#define SERVER_DEFAULT_WORKERS 4 //Worker threads if --workers isn't given.
+
+typedef struct {                    //Server settings
+    const char *input_file_name;    //Roster file (Loaded again when it changes)
+    const char *socket_file_name;   //Path of the Unix domain socket
+    int workers;                    //Worker threads answering requests
+    int threads;                    //Threads for parsing the roster (-j N)
+    long output_buffer_size;        //Bytes of a reply formatted before each write (--out-buffer)
+} ServerConfig;
+
+//Function to load the roster and answer requests until SIGINT or SIGTERM (Removes the socket file when it stops)
+void server_run(const ServerConfig *config);
+
+#endif // Ending #ifndef block
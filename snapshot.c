@@ -0,0 +1,287 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: snapshot.c has implemented functions for the binary snapshot of the student table.
+*		   snapshot_open() Memory-mapping a snapshot and checking it belongs to the input file.
+*		   snapshot_write() Writing the table and its gpa order as a snapshot.
+*		   snapshot_ingest() Using the snapshot instead of parsing, and parsing only lines appended after it.
+*		   snapshot_close() Unmapping the snapshot.
+*/
+
+#define _GNU_SOURCE //For memrchr(), fileno(), pread() and st_mtim
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "snapshot.h"
+#include "ingest.h"
+
+#define FNV_OFFSET_BASIS 14695981039346656037ull //Starting value of the checksum.
+#define FNV_PRIME 1099511628211ull //Multiplier of the checksum.
+#define SNAPSHOT_PATH_SIZE 4096 //Bytes for the name of the temporary snapshot file.
+
+typedef struct {        //One column of the snapshot
+    const void *data;   //First byte
+    size_t size;        //Bytes
+} SnapshotSection;
+
+//Function to add bytes to an FNV-1a checksum, 8 bytes at a time (Then the last few bytes one at a time).
+static uint64_t checksum_update(uint64_t hash, const void *data, size_t size) {
+	const unsigned char *bytes = data;
+	size_t i = 0;
+
+	for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+		uint64_t word;
+		memcpy(&word, bytes + i, sizeof(word));
+		hash = (hash ^ word) * FNV_PRIME;
+	}
+	for (; i < size; i++) {
+		hash = (hash ^ bytes[i]) * FNV_PRIME;
+	}
+	return hash;
+}
+
+//Function to list the columns of a table in snapshot order. Returns how many.
+static int table_sections(const StudentTable *table, SnapshotSection sections[]) {
+	size_t count = table->count;
+
+	sections[0] = (SnapshotSection){table->gpa, count * sizeof(int)};
+	sections[1] = (SnapshotSection){table->toefl, count * sizeof(int)};
+	sections[2] = (SnapshotSection){table->name_offset, count * sizeof(unsigned int)};
+	sections[3] = (SnapshotSection){table->gpa_order, count * sizeof(unsigned int)};
+	sections[4] = (SnapshotSection){table->status, count * sizeof(char)};
+	sections[5] = (SnapshotSection){table->name_pool, table->pool_size};
+	return 6;
+}
+
+//Function to checksum the first and last SNAPSHOT_EDGE_SIZE bytes of the first source_size bytes of the input.
+//Returns 0 if the input can't be read.
+static int input_edge_checksum(int fd, uint64_t source_size, uint64_t *checksum) {
+	char edge[SNAPSHOT_EDGE_SIZE];
+	size_t edge_size = source_size < SNAPSHOT_EDGE_SIZE ? source_size : SNAPSHOT_EDGE_SIZE;
+
+	*checksum = FNV_OFFSET_BASIS;
+	if (pread(fd, edge, edge_size, 0) != (ssize_t)edge_size) {
+		return 0;
+	}
+	*checksum = checksum_update(*checksum, edge, edge_size);
+	if (pread(fd, edge, edge_size, source_size - edge_size) != (ssize_t)edge_size) {
+		return 0;
+	}
+	*checksum = checksum_update(*checksum, edge, edge_size);
+	return 1;
+}
+
+//Function to check if the header was made from this input file. Same size and modification time, or with
+//append_only, the input is at least as big and its edges before source_size didn't change.
+static int header_matches_input(const SnapshotHeader *header, const struct stat *input_status, int fd,
+	int append_only) {
+	if (!append_only) {
+		return header->source_size == (uint64_t)input_status->st_size &&
+			header->source_mtime_sec == (int64_t)input_status->st_mtim.tv_sec &&
+			header->source_mtime_nsec == (int64_t)input_status->st_mtim.tv_nsec;
+	}
+
+	uint64_t edge_checksum;
+	return header->source_size <= (uint64_t)input_status->st_size &&
+		input_edge_checksum(fd, header->source_size, &edge_checksum) && edge_checksum == header->edge_checksum;
+}
+
+//Function to map a snapshot made from the opened input file.
+int snapshot_open(Snapshot *snapshot, const char *file_name, FILE *input_file, int append_only) {
+	struct stat input_status;
+	struct stat snapshot_status;
+
+	snapshot->data        = NULL;
+	snapshot->size        = 0;
+	snapshot->source_size = 0;
+	snapshot->invalid_toefl = 0;
+
+	FILE *file = fopen(file_name, "rb");
+	if (file == NULL) {
+		return 0;
+	}
+	if (fstat(fileno(input_file), &input_status) != 0 || fstat(fileno(file), &snapshot_status) != 0 ||
+		(size_t)snapshot_status.st_size < sizeof(SnapshotHeader)) {
+		fclose(file);
+		return 0;
+	}
+
+	void *mapping = mmap(NULL, snapshot_status.st_size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+	fclose(file);
+	if (mapping == MAP_FAILED) {
+		return 0;
+	}
+
+	SnapshotHeader header;
+	memcpy(&header, mapping, sizeof(header));
+
+	//Stale snapshots (Other version or input changed) are rebuilt quietly.
+	size_t columns_size = (size_t)header.count * (4 * sizeof(int) + sizeof(char)) + header.pool_size;
+	if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 || header.version != SNAPSHOT_VERSION ||
+		!header_matches_input(&header, &input_status, fileno(input_file), append_only) ||
+		(size_t)snapshot_status.st_size != sizeof(SnapshotHeader) + columns_size) {
+		munmap(mapping, snapshot_status.st_size);
+		return 0;
+	}
+
+	char *columns = (char *)mapping + sizeof(SnapshotHeader);
+	StudentTable *table = &snapshot->table;
+	table->count         = header.count;
+	table->capacity      = header.count;
+	table->gpa           = (int *)columns;
+	table->toefl         = table->gpa + header.count;
+	table->name_offset   = (unsigned int *)(table->toefl + header.count);
+	table->gpa_order     = table->name_offset + header.count;
+	table->status        = (char *)(table->gpa_order + header.count);
+	table->name_pool     = table->status + header.count;
+	table->pool_size     = header.pool_size;
+	table->pool_capacity = header.pool_size;
+	table->column_grows  = 0;
+	table->pool_grows    = 0;
+	memset(table->results, 0, sizeof(table->results));
+
+	//Throwing away a damaged snapshot (Checksum doesn't match).
+	SnapshotSection sections[6];
+	int num_of_sections = table_sections(table, sections);
+	uint64_t checksum   = FNV_OFFSET_BASIS;
+	for (int i = 0; i < num_of_sections; i++) {
+		checksum = checksum_update(checksum, sections[i].data, sections[i].size);
+	}
+	if (checksum != header.checksum) {
+		printf("Snapshot %s is damaged, rebuilding it :/\n\n", file_name);
+		munmap(mapping, snapshot_status.st_size);
+		return 0;
+	}
+
+	snapshot->data        = mapping;
+	snapshot->size        = snapshot_status.st_size;
+	snapshot->source_size = header.source_size;
+	snapshot->invalid_toefl = (long)header.invalid_toefl;
+	return 1;
+}
+
+//Function to write the table (With its gpa order) as a snapshot of the opened input file.
+int snapshot_write(const char *file_name, const StudentTable *table, FILE *input_file, size_t source_size,
+	long invalid_toefl) {
+	struct stat input_status;
+	char temp_name[SNAPSHOT_PATH_SIZE];
+	SnapshotHeader header = {0};
+
+	if (table->gpa_order == NULL || fstat(fileno(input_file), &input_status) != 0 ||
+		!input_edge_checksum(fileno(input_file), source_size, &header.edge_checksum) ||
+		snprintf(temp_name, sizeof(temp_name), "%s.tmp", file_name) >= (int)sizeof(temp_name)) {
+		return 0;
+	}
+
+	SnapshotSection sections[6];
+	int num_of_sections = table_sections(table, sections);
+
+	memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+	header.version           = SNAPSHOT_VERSION;
+	header.count             = table->count;
+	header.pool_size         = table->pool_size;
+	header.source_size       = source_size;
+	header.source_mtime_sec  = input_status.st_mtim.tv_sec;
+	header.source_mtime_nsec = input_status.st_mtim.tv_nsec;
+	header.invalid_toefl     = invalid_toefl;
+	header.checksum          = FNV_OFFSET_BASIS;
+	for (int i = 0; i < num_of_sections; i++) {
+		header.checksum = checksum_update(header.checksum, sections[i].data, sections[i].size);
+	}
+
+	FILE *file = fopen(temp_name, "wb");
+	if (file == NULL) {
+		return 0;
+	}
+
+	int written = fwrite(&header, sizeof(header), 1, file) == 1;
+	for (int i = 0; i < num_of_sections && written; i++) {
+		written = sections[i].size == 0 || fwrite(sections[i].data, sections[i].size, 1, file) == 1;
+	}
+	written = fclose(file) == 0 && written;
+
+	if (!written || rename(temp_name, file_name) != 0) {
+		remove(temp_name);
+		return 0;
+	}
+	return 1;
+}
+
+//Function to get the students of the input, from the snapshot file when it can, and bring the snapshot up to date.
+const StudentTable *snapshot_ingest(Snapshot *snapshot, const char *file_name, InputReader *reader, FILE *input_file,
+	StudentTable *table, int num_of_threads, int append_only) {
+	snapshot->data = NULL;
+
+	//Snapshots are made of regular (memory-mapped) files only.
+	if (!reader->mapped) {
+		table_init(table, MAX_STUDENT);
+		ingest_parallel(reader, table, num_of_threads, NULL);
+		table_shrink_to_fit(table);
+		return table;
+	}
+
+	long invalid_toefl = 0;
+	if (snapshot_open(snapshot, file_name, input_file, append_only)) {
+		invalid_toefl = snapshot->invalid_toefl;
+
+		//Lines in the snapshot aren't parsed again, so their messages are printed from the stored count.
+		for (long i = 0; i < invalid_toefl; i++) {
+			report_parse_result(PARSE_INVALID_TOEFL);
+		}
+
+		//Same input: no parsing at all.
+		if (snapshot->source_size == reader->size) {
+			return &snapshot->table;
+		}
+
+		//Input grew: starting from the snapshot's students and parsing only the lines after it.
+		table_copy(table, &snapshot->table, reader->size - snapshot->source_size);
+		reader->position = snapshot->source_size;
+		snapshot_close(snapshot);
+	} else {
+		table_init_for_input(table, reader->size);
+	}
+
+	//An append-only input may end in a line that's still being written. It's parsed for this run, but left out
+	//of the snapshot, so the next run parses it again when it's whole.
+	size_t start      = reader->position;
+	size_t input_size = reader->size;
+	size_t whole_size = input_size;
+	if (append_only) {
+		const char *last_newline = memrchr(reader->data + start, '\n', input_size - start);
+		whole_size = last_newline != NULL ? (size_t)(last_newline - reader->data) + 1 : start;
+	}
+
+	//Parsing the whole lines (The reader stops at whole_size) and merging them into the gpa order.
+	int first_new = table->count;
+	reader->size  = whole_size;
+	ingest_parallel(reader, table, num_of_threads, NULL);
+	invalid_toefl += table->results[PARSE_INVALID_TOEFL];
+	table_extend_gpa_order(table, first_new);
+
+	if ((whole_size > start || start == 0) && !snapshot_write(file_name, table, input_file, whole_size, invalid_toefl)) {
+		printf("Couldn't write snapshot %s :/\n\n", file_name);
+	}
+
+	//Then the unfinished last line, if there is one.
+	reader->size = input_size;
+	if (whole_size < input_size) {
+		first_new = table->count;
+		ingest_serial(reader, table, NULL);
+		table_extend_gpa_order(table, first_new);
+	}
+	table_shrink_to_fit(table);
+	return table;
+}
+
+//Function to unmap the snapshot.
+void snapshot_close(Snapshot *snapshot) {
+	if (snapshot->data != NULL) {
+		munmap(snapshot->data, snapshot->size);
+		snapshot->data = NULL;
+	}
+}
@@ -0,0 +1,69 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: Has the binary snapshot of the student table and its function prototypes (--snapshot).
+*          A snapshot is a header, then the gpa, TOEFL, name offset and gpa order columns (4 bytes each per student),
+*          the status column and the name pool. The header has the size and modification time of the input it was
+*          made from and a checksum of everything after it. Later runs memory-map it and skip parsing.
+*          Columns are written in this machine's byte order, so a snapshot is only read on the machine that made it.
+*
+*          Append-only inputs (--append-only) only grow, so a snapshot of a shorter version is still right for its part.
+*          The next run parses only the lines after it, merges them into the table and gpa order and writes a new
+*          snapshot. The first and last bytes before the snapshot's end are checked to catch an input that was replaced.
+*/
+#ifndef SNAPSHOT_H //Checking if SNAPSHOT_H is not defined
+#define SNAPSHOT_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "table.h"
+#include "input.h"
+
+#define SNAPSHOT_MAGIC "LAB6SNAP" //First 8 bytes of every snapshot.
+#define SNAPSHOT_VERSION 4 //Bumped whenever the layout changes (Older snapshots are rebuilt).
+#define SNAPSHOT_EDGE_SIZE 4096 //Bytes at the start and at the end of the snapshot's part of the input in edge_checksum.
+
+typedef struct {                //Snapshot header (72 bytes, columns start right after it)
+    char magic[8];              //SNAPSHOT_MAGIC
+    uint32_t version;           //SNAPSHOT_VERSION
+    uint32_t count;             //Number of students
+    uint64_t pool_size;         //Bytes of the name pool
+    uint64_t source_size;       //Bytes of the input in the snapshot (Whole lines, from the start)
+    int64_t source_mtime_sec;   //Modification time of the input file (Seconds)
+    int64_t source_mtime_nsec;  //Modification time of the input file (Nanoseconds)
+    uint64_t edge_checksum;     //FNV-1a of the first and last SNAPSHOT_EDGE_SIZE bytes of the input in the snapshot
+    uint64_t invalid_toefl;     //Lines of the input in the snapshot with an invalid TOEFL score
+    uint64_t checksum;          //FNV-1a of everything after the header
+} SnapshotHeader;
+
+typedef struct {            //Memory-mapped snapshot
+    void *data;             //Mapping of the whole snapshot file
+    size_t size;            //Bytes of the mapping
+    size_t source_size;     //Bytes of the input in the snapshot
+    long invalid_toefl;     //Lines of the input in the snapshot with an invalid TOEFL score
+    StudentTable table;     //Columns point into the mapping (Read only, don't table_free() it)
+} Snapshot;
+
+//Function to map a snapshot made from the opened input file. Returns 0 if it's missing, stale or damaged.
+//With append_only, a snapshot of the start of the input is also taken (Input only grew since).
+int snapshot_open(Snapshot *snapshot, const char *file_name, FILE *input_file, int append_only);
+
+//Function to write the table (With its gpa order) as a snapshot of the first source_size bytes of the input.
+//invalid_toefl is how many of those lines had an invalid TOEFL score. Returns 0 if it fails.
+//The snapshot is written next to file_name first and renamed, so a half written snapshot is never read.
+int snapshot_write(const char *file_name, const StudentTable *table, FILE *input_file, size_t source_size,
+    long invalid_toefl);
+
+//Function to get the students of the input, from the snapshot file when it can, and bring the snapshot up to date.
+//Returns the mapped snapshot's table if the input didn't change, or table filled with every student
+//(Gpa order too). Only lines after the snapshot are parsed. Inputs that aren't memory-mapped are parsed as usual.
+//"Invalid TOEFL score" is printed again for each such line in the snapshot, so the run prints what parsing would.
+//Not used with --rejects, which has to see every line again to write each bad one to the reject file.
+const StudentTable *snapshot_ingest(Snapshot *snapshot, const char *file_name, InputReader *reader, FILE *input_file,
+    StudentTable *table, int num_of_threads, int append_only);
+
+//Function to unmap the snapshot
+void snapshot_close(Snapshot *snapshot);
+
+#endif // Ending #ifndef block
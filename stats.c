@@ -0,0 +1,91 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: stats.c has implemented functions for the run statistics.
+*		   stats_start() Starting to time the run.
+*		   stats_end_stage() Ending one stage and starting the next one.
+*		   stats_add_table() Adding the counters and size of the table.
+*		   stats_print() Printing the statistics as JSON on stderr.
+*/
+
+#define _POSIX_C_SOURCE 200809L //For clock_gettime()
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "stats.h"
+
+//Function to get current time in seconds.
+static double now_seconds(void) {
+	struct timespec time_now;
+	clock_gettime(CLOCK_MONOTONIC, &time_now);
+	return time_now.tv_sec + time_now.tv_nsec / 1e9;
+}
+
+//Function to start timing the run.
+void stats_start(RunStats *stats, int enabled) {
+	memset(stats, 0, sizeof(*stats));
+	stats->enabled = enabled;
+
+	if (enabled) {
+		stats->run_start   = now_seconds();
+		stats->stage_start = stats->run_start;
+	}
+}
+
+//Function to end the current stage under name and start the next one.
+void stats_end_stage(RunStats *stats, const char *name) {
+	if (!stats->enabled || stats->num_of_stages == MAX_STAGES) {
+		return;
+	}
+
+	double now = now_seconds();
+	stats->stages[stats->num_of_stages++] = (StageTime){name, now - stats->stage_start};
+	stats->stage_start = now;
+}
+
+//Function to add the counters and size of the table.
+void stats_add_table(RunStats *stats, const StudentTable *table) {
+	for (int i = 0; i < NUM_OF_PARSE_RESULTS; i++) {
+		stats->results[i] += table->results[i];
+	}
+	stats->column_grows += table->column_grows;
+	stats->pool_grows   += table->pool_grows;
+
+	//Students the table has but this run didn't parse came from a snapshot.
+	stats->snapshot_rows += table->count - table->results[PARSE_OK];
+
+	//Gpa, TOEFL, name offset and status columns, the name pool and the gpa order.
+	stats->table_bytes += (size_t)table->capacity * (sizeof(int) * 2 + sizeof(unsigned int) + sizeof(char)) +
+		table->pool_capacity + (table->gpa_order != NULL ? (size_t)table->count * sizeof(unsigned int) : 0);
+}
+
+//Function to print the statistics as JSON on stderr.
+void stats_print(const RunStats *stats) {
+	if (!stats->enabled) {
+		return;
+	}
+
+	struct rusage usage;
+	long peak_rss_bytes = getrusage(RUSAGE_SELF, &usage) == 0 ? usage.ru_maxrss * 1024L : 0; //ru_maxrss is in KB.
+	long lines          = stats->snapshot_rows;
+	for (int i = 0; i < NUM_OF_PARSE_RESULTS; i++) {
+		lines += stats->results[i];
+	}
+
+	fprintf(stderr, "{\"stages\": [");
+	for (int i = 0; i < stats->num_of_stages; i++) {
+		fprintf(stderr, "%s{\"name\": \"%s\", \"seconds\": %.6f}", i > 0 ? ", " : "", stats->stages[i].name,
+			stats->stages[i].seconds);
+	}
+	fprintf(stderr, "], \"total_seconds\": %.6f, \"lines\": %ld, \"snapshot_rows\": %ld, \"accepted\": %ld, "
+		"\"rejected\": {", stats->stage_start - stats->run_start, lines, stats->snapshot_rows,
+		stats->results[PARSE_OK] + stats->snapshot_rows);
+	for (int i = PARSE_OK + 1; i < NUM_OF_PARSE_RESULTS; i++) {
+		fprintf(stderr, "%s\"%s\": %ld", i > PARSE_OK + 1 ? ", " : "", parse_result_name(i), stats->results[i]);
+	}
+	fprintf(stderr, "}, \"reallocs\": {\"columns\": %d, \"name_pool\": %d}, \"table_bytes\": %zu, "
+		"\"peak_rss_bytes\": %ld, \"output_bytes\": %zu}\n", stats->column_grows, stats->pool_grows,
+		stats->table_bytes, peak_rss_bytes, stats->output_bytes);
+}
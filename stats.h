@@ -0,0 +1,49 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: Has the run statistics (--stats) and their function prototypes.
+*          Wall time of each stage, lines read, students accepted and rejected (By reason), reallocations of the
+*          table, bytes of the table, peak resident memory (peak_rss_bytes, so mapped input pages count too, not
+*          only the heap) and bytes written. Printed as one JSON object on stderr, so the output file and the usual
+*          messages stay the same. Students taken from a snapshot count as lines read and accepted (snapshot_rows).
+*/
+#ifndef STATS_H //Checking if STATS_H is not defined
+#define STATS_H
+
+#include <stddef.h>
+#include "table.h"
+
+#define MAX_STAGES 8 //Most stages timed in one run.
+
+typedef struct {        //Wall time of one stage
+    const char *name;   //Stage name ("ingest", "query", ...)
+    double seconds;     //Wall time in seconds
+} StageTime;
+
+typedef struct {                        //Run statistics
+    int enabled;                        //1 if --stats was given (Nothing is timed otherwise)
+    double run_start;                   //When the run started (Seconds)
+    double stage_start;                 //When the current stage started (Seconds)
+    StageTime stages[MAX_STAGES];       //Finished stages, in order
+    int num_of_stages;                  //Number of finished stages
+    long results[NUM_OF_PARSE_RESULTS]; //Lines read, by PARSE_ result
+    long snapshot_rows;                 //Students taken from a snapshot instead of parsed
+    int column_grows;                   //Times the table columns were reallocated
+    int pool_grows;                     //Times the name pool was reallocated
+    size_t table_bytes;                 //Bytes allocated (or mapped) for the table
+    size_t output_bytes;                //Bytes written to every output file
+} RunStats;
+
+//Function to start timing the run (Only timed if enabled is 1)
+void stats_start(RunStats *stats, int enabled);
+
+//Function to end the current stage under name and start the next one
+void stats_end_stage(RunStats *stats, const char *name);
+
+//Function to add the counters and size of the table
+void stats_add_table(RunStats *stats, const StudentTable *table);
+
+//Function to print the statistics as JSON on stderr (Does nothing if not enabled)
+void stats_print(const RunStats *stats);
+
+#endif // Ending #ifndef block
@@ -0,0 +1,178 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: stream.c has implemented functions for the streaming filter.
+*		   stream_filter() Checking each line against a query while reading and writing matches right away.
+*		   stream_top() Keeping only the best N matches by gpa while reading, then writing them.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "stream.h"
+#include "scan.h"
+#include "table.h"
+#include "topk.h"
+
+typedef struct {            //One kept student of stream_top() (Names are copied, the line goes away)
+    char *name;             //"first last" (Not null terminated)
+    size_t name_length;     //Bytes of name
+    size_t name_capacity;   //Bytes allocated for name (Reused by the next student in this slot)
+    int gpa;                //GPA as GPA_SCALE x thousandths
+    char status;            //Student status ('D' or 'I')
+    int toefl;              //TOEFL (0 for domestic students)
+} StreamSlot;
+
+//Function to parse one streamed line and count its result. Bad lines are reported like ingest_serial() does, or go
+//to the reject log. Returns the PARSE_ result, or -1 if reading has to stop (Reject rate too high).
+static int parse_streamed_line(Slice file_line, ParsedStudent *student, long results[], RejectLog *rejects) {
+	int result;
+
+	if (rejects == NULL) {
+		result = parse_student(file_line, student);
+		report_parse_result(result);
+	} else {
+		result = rejects->limit_line_length && file_line.length > MAX_LINE_LENGTH ? PARSE_LINE_TOO_LONG :
+			parse_student(file_line, student);
+	}
+	results[result]++;
+
+	if (rejects != NULL && !reject_count_line(rejects, result)) {
+		return -1;
+	}
+	return result;
+}
+
+//Function to write students matching the query while the input is read.
+void stream_filter(InputReader *reader, OutputWriter *writer, const Query *query, long results[],
+	RejectLog *rejects) {
+	Slice file_line;
+	ParsedStudent student;
+	long num_of_written = 0;
+
+	//Stopping early once the limit is reached.
+	while ((query->limit == NO_LIMIT || num_of_written < query->limit) && input_next_line(reader, &file_line)) {
+		int result = parse_streamed_line(file_line, &student, results, rejects);
+
+		if (result < 0) {
+			return;
+		}
+
+		if (result != PARSE_OK || !scan_matches(&query->filter, student.gpa, student.toefl, student.status)) {
+			continue;
+		}
+		num_of_written++;
+
+		//Writing straight from the line, so the name is never copied. First name and space go first.
+		writer_write(writer, student.first_name.start, student.first_name.length);
+		writer_write(writer, " ", 1);
+		writer_write_student(writer, student.last_name.start, student.last_name.length, student.gpa, student.status,
+			query->show_toefl ? student.toefl : 0);
+	}
+}
+
+//Function to copy a parsed student into a slot, growing the slot's name only if it's too small.
+static void fill_slot(StreamSlot *slot, const ParsedStudent *student) {
+	size_t name_length = student->first_name.length + 1 + student->last_name.length;
+
+	if (name_length > slot->name_capacity) {
+		char *name = realloc(slot->name, name_length);
+
+		//Throwing an error, if memory allocation failed.
+		if (name == NULL) {
+			puts("Memory allocation for student name failed :(\n");
+			exit(1);
+		}
+		slot->name          = name;
+		slot->name_capacity = name_length;
+	}
+	memcpy(slot->name, student->first_name.start, student->first_name.length);
+	slot->name[student->first_name.length] = ' ';
+	memcpy(slot->name + student->first_name.length + 1, student->last_name.start, student->last_name.length);
+	slot->name_length = name_length;
+	slot->gpa         = student->gpa;
+	slot->status      = student->status;
+	slot->toefl       = student->toefl;
+}
+
+//Function to double the slots of stream_top() (Never past limit). New slots have no name yet.
+static StreamSlot *grow_slots(StreamSlot *slots, int *num_of_slots, int limit) {
+	int old_count = *num_of_slots;
+	int new_count = old_count == 0 ? (limit < TOPK_FIRST_ALLOCATION ? limit : TOPK_FIRST_ALLOCATION) :
+		(old_count > limit / 2 ? limit : old_count * 2);
+	StreamSlot *grown = realloc(slots, new_count * sizeof(StreamSlot));
+
+	//Throwing an error, if memory reallocation failed.
+	if (grown == NULL) {
+		puts("Memory reallocation for top students failed :/\n");
+		exit(1);
+	}
+	memset(grown + old_count, 0, (new_count - old_count) * sizeof(StreamSlot));
+	*num_of_slots = new_count;
+	return grown;
+}
+
+//Function to write the best query->limit students matching the query by gpa, while the input is read.
+void stream_top(InputReader *reader, OutputWriter *writer, const Query *query, long results[],
+	RejectLog *rejects) {
+	int descending    = query->order != ORDER_GPA_ASC;
+	StreamSlot *slots = NULL;
+	int num_of_slots  = 0;      //Slots allocated (Grows with the students kept, so a big limit costs nothing)
+
+	TopK top;
+	topk_init(&top, query->limit);
+
+	Slice file_line;
+	ParsedStudent student;
+	unsigned int sequence = 0;  //Valid students read so far (Same as the table index)
+
+	while (input_next_line(reader, &file_line)) {
+		int result = parse_streamed_line(file_line, &student, results, rejects);
+
+		if (result < 0) {
+			break;
+		}
+		if (result != PARSE_OK) {
+			continue;
+		}
+		unsigned long long key = topk_key(student.gpa, student.status, sequence++, descending);
+
+		if (!scan_matches(&query->filter, student.gpa, student.toefl, student.status) || !topk_accepts(&top, key)) {
+			continue;
+		}
+
+		//A new student takes the slot of the one it pushes out, so there are never more than limit slots.
+		unsigned int slot = topk_next_evicted(&top);
+		if (slot == TOPK_NONE) {
+			slot = top.count;
+		}
+		if ((int)slot == num_of_slots) {
+			slots = grow_slots(slots, &num_of_slots, query->limit);
+		}
+		fill_slot(&slots[slot], &student);
+		topk_insert(&top, key, slot);
+	}
+
+	unsigned int *order = malloc((top.count > 0 ? top.count : 1) * sizeof(unsigned int));
+
+	//Throwing an error, if memory allocation failed.
+	if (order == NULL) {
+		puts("Memory allocation for top students failed :(\n");
+		exit(1);
+	}
+
+	int num_of_kept = topk_finish(&top, order);
+	for (int i = 0; i < num_of_kept; i++) {
+		const StreamSlot *kept = &slots[order[i]];
+		writer_write_student(writer, kept->name, kept->name_length, kept->gpa, kept->status,
+			query->show_toefl ? kept->toefl : 0);
+	}
+
+	//Slots are taken in order and never given back, so the kept students used the first num_of_kept of them.
+	for (int i = 0; i < num_of_kept; i++) {
+		free(slots[i].name);
+	}
+	free(slots);
+	free(order);
+	topk_free(&top);
+}
@@ -0,0 +1,31 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: Has the function prototypes for the streaming filter (--stream).
+*          Queries without "order by" (Options 1 ~ 3) only look at one student at a time, so each line is checked
+*          as soon as it's parsed and written right away. Memory use stays the same however big the input is.
+*          Queries ordered by gpa with a limit (--top N) keep only the best N students while reading.
+*/
+#ifndef STREAM_H //Checking if STREAM_H is not defined
+#define STREAM_H
+
+#include <stdio.h>
+#include "input.h"
+#include "writer.h"
+#include "query.h"
+#include "reject.h"
+
+//Function to write students matching the query while the input is read (No student is kept in memory)
+//Query order is ignored: option 3 writes students in input order, not 1st domestic, 1st international, ...
+//Each line read adds one to results[] of its PARSE_ result. Bad lines go to rejects if it isn't NULL (--rejects),
+//and reading stops if its reject rate gets too high (rejects->aborted is set).
+void stream_filter(InputReader *reader, OutputWriter *writer, const Query *query, long results[],
+    RejectLog *rejects);
+
+//Function to write the best query->limit students matching the query by gpa (Query has to have a limit)
+//Only limit students are kept in memory. Same students and order as sorting the whole table.
+//Results and bad lines are counted like stream_filter().
+void stream_top(InputReader *reader, OutputWriter *writer, const Query *query, long results[],
+    RejectLog *rejects);
+
+#endif // Ending #ifndef block
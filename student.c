@@ -15,8 +15,12 @@
 *		   domestic_with_good_GPA() Getting only domestic students with GPA > 3.9.
 *		   internation_with_good_GPA_and_toefl() Getting only international students with GPA > 3.9 and TOEFL >= 70.
 *		   all_student_with_good_GPA() Getting all students with GPA > 3.9 and TOEFL >= 70.
-*		   fprintf_sorted_gpa() Organising students' gpa in descending order by using selection sort
-*		   free_all_allocate_memory() Freeing all allocated memory.
+*		   sort_students_gpa() Organising students' gpa in descending order by using selection sort.
+*		   merge_sort_students_gpa() Organising students' gpa in descending order by using stable merge sort.
+*		   radix_sort_keys() Sorting values by unsigned keys with LSD radix sort (Shared by every radix sort).
+*		   radix_sort_students_gpa() Organising students' gpa in descending order by using radix sort on fixed-point gpa.
+*		   fprintf_sorted_gpa() Writing students' gpa in descending order (Radix sort, merge sort as fallback).
+*		   free_all_allocate_memory() Freeing all allocated memory (Names are freed with the names arena).
 */
 
 #include <stdio.h>
@@ -68,7 +72,7 @@ void allocate_memory_for_students(Domestic **domestic_students, International **
 }
 
 //Function to parse each line of input file (domestic cases, international cases).
-void parse_line_of_file(char *line, Domestic *domestic, International *international) {
+void parse_line_of_file(char *line, Domestic *domestic, International *international, Arena *names) {
 
     //Splitting line of string into multiple pieces(tokens) using delimiters.(Need string.h header file)
     char *first_name            = strtok(line, " ");
@@ -86,9 +90,9 @@ void parse_line_of_file(char *line, Domestic *domestic, International *internati
     //For domestic student and international student
     //Copying data into domestic struct and international struct
     if (student_status_char[0] == 'D') {
-    	fill_domestic_up(domestic, first_name, last_name, gpa_in_line, student_status_char);
+    	fill_domestic_up(domestic, names, first_name, last_name, gpa_in_line, student_status_char);
     } else if (student_status_char[0] == 'I') {
-    	fill_international_up(international, first_name, last_name, gpa_in_line, student_status_char, toefl);
+    	fill_international_up(international, names, first_name, last_name, gpa_in_line, student_status_char, toefl);
 
     	//Validating toefl score to make sure it's international students' data.
     	if(international->toefl <= 0) {
@@ -98,18 +102,12 @@ void parse_line_of_file(char *line, Domestic *domestic, International *internati
 }
 
 //Function to fill up parsed data into Domestic struct.
-void fill_domestic_up(Domestic *domestic, const char *first_name, const char *last_name, const char *gpa_in_line,
-	const char *student_status_char) {
+void fill_domestic_up(Domestic *domestic, Arena *names, const char *first_name, const char *last_name,
+	const char *gpa_in_line, const char *student_status_char) {
 
-	//Allocating memory for domestic students' names and international students' names.
+	//Getting memory for domestic students' names from the names arena (Arena exits if allocation fails).
 	// +2 --> 1 for space between fist name and last name. 1 for null terminator.
-	domestic->name       = (char *)malloc(strlen(first_name) + strlen(last_name) + 2);
-
-	//Throwing an error, if memory allocation failed.
-	if (domestic->name == NULL) {
-		puts("Memory allocation failed :(\n");
-		exit(1);
-	}
+	domestic->name       = arena_alloc(names, strlen(first_name) + strlen(last_name) + 2);
 
 	//String concatenation for first and last name and make it as one name
 	strcpy(domestic->name, first_name);
@@ -124,18 +122,12 @@ void fill_domestic_up(Domestic *domestic, const char *first_name, const char *la
 }
 
 //Function to fill up parsed data into International struct.
-void fill_international_up(International *international, const char *first_name, const char *last_name, const char *gpa_in_line,
-	const char *student_status_char, const char *toefl) {
+void fill_international_up(International *international, Arena *names, const char *first_name,
+	const char *last_name, const char *gpa_in_line, const char *student_status_char, const char *toefl) {
 
-	//Allocating memory for domestic students' names and international students' names.
+	//Getting memory for international students' names from the names arena (Arena exits if allocation fails).
 	// +2 --> 1 for space between fist name and last name. 1 for null terminator.
-	international->name  = (char *)malloc(strlen(first_name) + strlen(last_name) + 2);
-
-	//Throwing an error, if memory allocation failed.
-	if (international->name == NULL) {
-		puts("Memory allocation failed :(\n");
-		exit(1);
-	}
+	international->name  = arena_alloc(names, strlen(first_name) + strlen(last_name) + 2);
 
 	//String concatenation for first and last name and make it as one name
 	strcpy(international->name, first_name);
@@ -170,12 +162,12 @@ int validate_international(International *international) {
 }
 
 //Function to reallocate memory if domestic student is more than allocated memory.
-void reallocate_domestic(Domestic **domestic, int domestic_students_count, int *max_student) {
+void reallocate_domestic(Domestic **domestic, int domestic_students_count, int *max_domestic) {
 
-	//If domestic student is more than max students(150), reallocate memory
-	if(domestic_students_count >= *max_student) {
-		*max_student *= 2;
-		*domestic = realloc(*domestic, (*max_student) * sizeof(Domestic));
+	//If domestic student is more than the domestic array holds, reallocate memory
+	if(domestic_students_count >= *max_domestic) {
+		*max_domestic *= 2;
+		*domestic = realloc(*domestic, (*max_domestic) * sizeof(Domestic));
 
 		//Throwing an error, if memory reallocation failed.
 		if (*domestic == NULL) {
@@ -187,12 +179,13 @@ void reallocate_domestic(Domestic **domestic, int domestic_students_count, int *
 }
 
 //Function to reallocate memory if international student is more than allocated memory.
-void reallocate_international(International **international, int international_students_count, int *max_student) {
+void reallocate_international(International **international, int international_students_count,
+	int *max_international) {
 
-	//If international student is more than max students(150), reallocate memory
-	if(international_students_count >= *max_student) {
-		*max_student *= 2;
-		*international = realloc(*international, (*max_student) * sizeof(International));
+	//If international student is more than the international array holds, reallocate memory
+	if(international_students_count >= *max_international) {
+		*max_international *= 2;
+		*international = realloc(*international, (*max_international) * sizeof(International));
 
 		//Throwing an error, if memory reallocation failed.
 		if (*international == NULL) {
@@ -296,7 +289,211 @@ void sort_students_gpa(void **students, int count) {
 	}
 }
 
-//Function to write file for students sorted their gpa in ascending order.
+//Function to check if a gpa can be stored as thousandths in a radix sort key (Not negative, NaN or too large).
+static inline int gpa_fits_key(float gpa) {
+	return gpa >= 0.000f && gpa < 4000000.000f;
+}
+
+//Function to get a gpa in thousandths, like it's written with "%.3f" (Only for gpa_fits_key() gpa).
+static inline unsigned int gpa_thousandths(float gpa) {
+	return (unsigned int)((double)gpa * 1000.0 + 0.5);
+}
+
+//Function to read gpa of a student behind a generic pointer (Domestic or International).
+static float gpa_of_student(const void *student) {
+	return ((const Domestic*)student) -> domestic_char == 'D' ?
+		((const Domestic*)student) -> gpa :
+		((const International*)student) -> gpa;
+}
+
+//Function to sort values by their keys by using LSD radix sort (Stable, keys are reordered with them).
+//high_bits has every bit any key may differ in, so the second pass is skipped when they all fit in RADIX_BITS.
+void radix_sort_keys(unsigned int *keys, unsigned int *values, int count, unsigned int high_bits) {
+	if (count < 2) {
+		return;
+	}
+
+	unsigned int *temp_keys   = malloc(count * sizeof(unsigned int));
+	unsigned int *temp_values = malloc(count * sizeof(unsigned int));
+	unsigned int *counts      = malloc(RADIX_BUCKETS * sizeof(unsigned int));
+
+	//Throwing an error, if memory allocation failed.
+	if (temp_keys == NULL || temp_values == NULL || counts == NULL) {
+		puts("Memory allocation for sorting failed :(\n");
+		exit(1);
+	}
+
+	unsigned int *src_keys   = keys;
+	unsigned int *dst_keys   = temp_keys;
+	unsigned int *src_values = values;
+	unsigned int *dst_values = temp_values;
+
+	//One counting pass per 16 bits of key.
+	int passes = (high_bits >> RADIX_BITS) == 0 ? 1 : 2;
+
+	for (int pass = 0; pass < passes; pass++) {
+		int shift = pass * RADIX_BITS;
+
+		memset(counts, 0, RADIX_BUCKETS * sizeof(unsigned int));
+		for (int i = 0; i < count; i++) {
+			counts[(src_keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+		}
+
+		//Turning counts into starting positions of each bucket.
+		unsigned int position = 0;
+		for (int bucket = 0; bucket < RADIX_BUCKETS; bucket++) {
+			unsigned int bucket_count = counts[bucket];
+			counts[bucket] = position;
+			position += bucket_count;
+		}
+
+		for (int i = 0; i < count; i++) {
+			unsigned int bucket = (src_keys[i] >> shift) & (RADIX_BUCKETS - 1);
+			dst_keys[counts[bucket]]     = src_keys[i];
+			dst_values[counts[bucket]++] = src_values[i];
+		}
+
+		unsigned int *swap_keys = src_keys;
+		src_keys = dst_keys;
+		dst_keys = swap_keys;
+
+		unsigned int *swap_values = src_values;
+		src_values = dst_values;
+		dst_values = swap_values;
+	}
+
+	//Copying back if the last pass ended up in the temporary arrays.
+	if (src_values != values) {
+		memcpy(keys, src_keys, count * sizeof(unsigned int));
+		memcpy(values, src_values, count * sizeof(unsigned int));
+	}
+
+	free(temp_keys);
+	free(temp_values);
+	free(counts);
+}
+
+//Function to organise students' gpa in descending order by using bottom-up merge sort (Stable, O(n log n)).
+void merge_sort_students_gpa(void **students, int count) {
+	if (count < 2) {
+		return;
+	}
+
+	//Reading gpa once per student, so comparisons don't have to check domestic_char again.
+	float *keys      = malloc(count * sizeof(float));
+	float *temp_keys = malloc(count * sizeof(float));
+	void **temp      = malloc(count * sizeof(void*));
+
+	//Throwing an error, if memory allocation failed.
+	if (keys == NULL || temp_keys == NULL || temp == NULL) {
+		puts("Memory allocation for sorting failed :(\n");
+		exit(1);
+	}
+
+	for (int i = 0; i < count; i++) {
+		keys[i] = gpa_of_student(students[i]);
+	}
+
+	float *src_keys = keys;
+	float *dst_keys = temp_keys;
+	void **src      = students;
+	void **dst      = temp;
+
+	//Merging runs of width 1, 2, 4, ... until one run covers every student.
+	for (int width = 1; width < count; width *= 2) {
+		for (int left = 0; left < count; left += 2 * width) {
+			int middle = left + width < count ? left + width : count;
+			int right  = left + 2 * width < count ? left + 2 * width : count;
+			int i = left;
+			int j = middle;
+			int k = left;
+
+			//Taking left student on equal gpa keeps the original order (Stable).
+			while (i < middle && j < right) {
+				if (src_keys[i] >= src_keys[j]) {
+					dst_keys[k] = src_keys[i];
+					dst[k++]    = src[i++];
+				} else {
+					dst_keys[k] = src_keys[j];
+					dst[k++]    = src[j++];
+				}
+			}
+			while (i < middle) {
+				dst_keys[k] = src_keys[i];
+				dst[k++]    = src[i++];
+			}
+			while (j < right) {
+				dst_keys[k] = src_keys[j];
+				dst[k++]    = src[j++];
+			}
+		}
+
+		float *swap_keys = src_keys;
+		src_keys = dst_keys;
+		dst_keys = swap_keys;
+
+		void **swap_students = src;
+		src = dst;
+		dst = swap_students;
+	}
+
+	//Copying back if the last merge ended up in the temporary array.
+	if (src != students) {
+		memcpy(students, src, count * sizeof(void*));
+	}
+
+	free(keys);
+	free(temp_keys);
+	free(temp);
+}
+
+//Function to organise students' gpa in descending order by using LSD radix sort on fixed-point gpa (Stable, O(n)).
+//Returns 0 without touching the array if a gpa can't be stored as thousandths (negative, NaN or too large).
+int radix_sort_students_gpa(void **students, int count) {
+	if (count < 2) {
+		return 1;
+	}
+
+	unsigned int *keys  = malloc(count * sizeof(unsigned int));
+	unsigned int *order = malloc(count * sizeof(unsigned int));
+	void **temp         = malloc(count * sizeof(void*));
+
+	//Throwing an error, if memory allocation failed.
+	if (keys == NULL || order == NULL || temp == NULL) {
+		puts("Memory allocation for sorting failed :(\n");
+		exit(1);
+	}
+
+	//Gpa is written with three decimal places, so thousandths is the key. Inverting it gives descending order.
+	unsigned int high_bits = 0;
+	for (int i = 0; i < count; i++) {
+		float gpa = gpa_of_student(students[i]);
+
+		if (!gpa_fits_key(gpa)) {
+			free(keys);
+			free(order);
+			free(temp);
+			return 0;
+		}
+		keys[i]    = ~gpa_thousandths(gpa);
+		order[i]   = i;
+		high_bits |= ~keys[i];
+	}
+
+	//Sorting positions by key, then moving the students to their sorted positions.
+	radix_sort_keys(keys, order, count, high_bits);
+	for (int i = 0; i < count; i++) {
+		temp[i] = students[order[i]];
+	}
+	memcpy(students, temp, count * sizeof(void*));
+
+	free(keys);
+	free(order);
+	free(temp);
+	return 1;
+}
+
+//Function to write file for students sorted their gpa in descending order.
 void fprintf_sorted_gpa(FILE *file2, Domestic *domestic_students, International *international_students,
 								int domestic_count, int international_count) {
 
@@ -305,6 +502,12 @@ void fprintf_sorted_gpa(FILE *file2, Domestic *domestic_students, International
 	//Allocate memory for holding the entire students. Using generic pointer for any data type.
 	void **all_students = malloc(total_students_count * sizeof(void*));
 
+	//Throwing an error, if memory allocation failed.
+	if (all_students == NULL && total_students_count > 0) {
+		puts("Memory allocation for all_students failed :(\n");
+		exit(1);
+	}
+
 	//Adding domestic students in all_students array
 	for(int i = 0; i < domestic_count; i++) {
 		all_students[i] = &domestic_students[i];
@@ -314,7 +517,10 @@ void fprintf_sorted_gpa(FILE *file2, Domestic *domestic_students, International
 		all_students[domestic_count + i] = &international_students[i];
 	}
 
-	sort_students_gpa(all_students, total_students_count);
+	//Radix sort on printed gpa. Falling back to merge sort if some gpa doesn't fit a fixed-point key.
+	if (!radix_sort_students_gpa(all_students, total_students_count)) {
+		merge_sort_students_gpa(all_students, total_students_count);
+	}
 
 	//Writing file
 	for(int i = 0; i < total_students_count; i++) {
@@ -335,15 +541,11 @@ void fprintf_sorted_gpa(FILE *file2, Domestic *domestic_students, International
 }
 
 //Function to free all allocated memory
-void free_all_allocate_memory(Domestic *domestic_students, International *international_students, int domestic_count,
-	int international_count, char * file_line) {
+void free_all_allocate_memory(Domestic *domestic_students, International *international_students, Arena *names,
+	char * file_line) {
 
-	for(int i = 0; i < domestic_count; i ++) {
-		free(domestic_students[i].name);
-	}
-	for(int i = 0; i < international_count; i ++) {
-		free(international_students[i].name);
-	}
+	//Every name is in the names arena, so they are freed in one call.
+	arena_free(names);
 	free(domestic_students);
 	free(international_students);
 	free(file_line);
@@ -7,9 +7,13 @@
 #ifndef STUDENT_H //Checking if STUDENT_H is not defined
 #define STUDENT_H
 
+#include "arena.h"
+
 #define MAX_LINE_LENGTH 150 //Max number of length per line (Using for malloc when read file).
 #define MAX_NAME_LENGTH 50 //Max number of name.
 #define MAX_STUDENT 150 //Max number of students.
+#define RADIX_BITS 16 //Number of key bits sorted per radix sort pass.
+#define RADIX_BUCKETS (1 << RADIX_BITS) //Number of buckets per radix sort pass.
 
 typedef struct {    //Domestic struct
     char *name;
@@ -36,15 +40,15 @@ char* allocate_memory_for_line(FILE *file1, FILE *file2);
 void allocate_memory_for_students(Domestic **domestic_students, International **international_students);
 
 //Parsing each line of input file (domestic cases, international cases)
-void parse_line_of_file(char *line, Domestic *domestic, International *international);
+void parse_line_of_file(char *line, Domestic *domestic, International *international, Arena *names);
 
-//Fill up parsed data into Domestic struct
-void fill_domestic_up(Domestic *domestic, const char *first_name, const char *last_name, const char *gpa_in_line,
-    const char *student_status_char);
+//Fill up parsed data into Domestic struct (Name is allocated from names arena)
+void fill_domestic_up(Domestic *domestic, Arena *names, const char *first_name, const char *last_name,
+    const char *gpa_in_line, const char *student_status_char);
 
-//Fill up parsed data into International struct
-void fill_international_up(International *international, const char *first_name, const char *last_name,
-    const char *gpa_in_line, const char *student_status_char, const char *toefl);
+//Fill up parsed data into International struct (Name is allocated from names arena)
+void fill_international_up(International *international, Arena *names, const char *first_name,
+    const char *last_name, const char *gpa_in_line, const char *student_status_char, const char *toefl);
 
 //Function to validate for domestic student data
 int validate_domestic(Domestic *domestic);
@@ -53,10 +57,13 @@ int validate_domestic(Domestic *domestic);
 int validate_international(International *international);
 
 //Function to reallocate memory if domestic student is more than allocated memory.
-void reallocate_domestic(Domestic **domestic, int domestic_students_count, int *max_student);
+//max_domestic is the capacity of the domestic array only (Don't share it with the international array).
+void reallocate_domestic(Domestic **domestic, int domestic_students_count, int *max_domestic);
 
 //Function to reallocate memory if international student is more than allocated memory.
-void reallocate_international(International **international, int international_students_count, int *max_student);
+//max_international is the capacity of the international array only (Don't share it with the domestic array).
+void reallocate_international(International **international, int international_students_count,
+    int *max_international);
 
 //Function to get only domestic students with GPA > 3.9
 void domestic_with_good_GPA(FILE *file2, Domestic *domestic, int num_of_student);
@@ -68,12 +75,26 @@ void internation_with_good_GPA_and_toefl(FILE *file2, International *internation
 void all_student_with_good_GPA(FILE *file2, Domestic *domestic, International *international,
     int num_of_domestic, int num_of_international);
 
-//Function to organise students' gpa in descending order by using selection sort
+//Function to organise students' gpa in descending order by using selection sort (O(n^2), kept for comparison)
+void sort_students_gpa(void **students, int count);
+
+//Function to organise students' gpa in descending order by using stable merge sort (O(n log n))
+void merge_sort_students_gpa(void **students, int count);
+
+//Function to sort values by their keys by using stable LSD radix sort (Keys are reordered along with the values)
+//high_bits is every bit any key may differ in (One pass instead of two if they fit in RADIX_BITS).
+void radix_sort_keys(unsigned int *keys, unsigned int *values, int count, unsigned int high_bits);
+
+//Function to organise students' gpa in descending order by using stable radix sort on gpa in thousandths (O(n))
+//Returns 0 if a gpa can't be used as a fixed-point key.
+int radix_sort_students_gpa(void **students, int count);
+
+//Function to write all students with gpa in descending order (Equal gpa keeps domestic first, then input order)
 void fprintf_sorted_gpa(FILE *file2, Domestic *domestic_students, International *international_students,
                                 int domestic_count, int international_count);
 
-//Freeing all allocated memory
-void free_all_allocate_memory(Domestic *domestic_students, International *international_students, int domestic_count,
-    int international_count, char * file_line);
+//Freeing all allocated memory (Every name is freed at once with the names arena)
+void free_all_allocate_memory(Domestic *domestic_students, International *international_students, Arena *names,
+    char * file_line);
 
 #endif // Ending #ifndef block
\ No newline at end of file
@@ -0,0 +1,511 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: table.c has implemented functions for the columnar student table.
+*		   table_init() Allocating memory for the table columns and name pool.
+*		   table_append() Adding one student at the end of the table (Copies the name into the name pool).
+*		   table_reserve() Making sure the table can hold a number of students without growing.
+*		   table_append_table() Adding every student of another table at the end of the table.
+*		   table_copy() Allocating a table as a copy of another table.
+*		   table_init_for_input() Allocating a table sized for its input.
+*		   table_shrink_to_fit() Making the columns and name pool exactly as big as what they hold.
+*		   parse_student() Parsing one line of input file in place.
+*		   parse_line_into_table() Parsing each line of input file and adding valid students to the table.
+*		   parse_line_into_table_limited() Same, but lines longer than MAX_LINE_LENGTH are rejected (--rejects).
+*		   report_parse_result() Printing the message for a parse result.
+*		   parse_result_name() Getting the name of a parse result.
+*		   table_write_student() Writing one student.
+*		   table_allocate_indices() Allocating room for the index of every student.
+*		   table_interleave_indices() Putting selected students as 1st domestic, 1st international, 2nd domestic, ...
+*		   table_sort_indices_by_gpa() Sorting selected students by gpa (Stable, domestic first on equal gpa).
+*		   table_top_indices_by_gpa() Keeping only the best N selected students by gpa, in sorted order.
+*		   table_build_gpa_order() Sorting every student by gpa once, for snapshots and option 4.
+*		   table_extend_gpa_order() Merging appended students into the gpa order without sorting it again.
+*		   table_free() Freeing all memory of the table.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "table.h"
+#include "topk.h"
+
+//Function to allocate memory for capacity students and pool_capacity bytes of names.
+static void table_init_sized(StudentTable *table, int capacity, size_t pool_capacity) {
+	table->gpa           = malloc(capacity * sizeof(int));
+	table->toefl         = malloc(capacity * sizeof(int));
+	table->status        = malloc(capacity * sizeof(char));
+	table->name_offset   = malloc(capacity * sizeof(unsigned int));
+	table->name_pool     = malloc(pool_capacity);
+	table->count         = 0;
+	table->capacity      = capacity;
+	table->pool_size     = 0;
+	table->pool_capacity = pool_capacity;
+	table->gpa_order     = NULL;
+	table->column_grows  = 0;
+	table->pool_grows    = 0;
+	memset(table->results, 0, sizeof(table->results));
+
+	//Throwing an error, if memory allocation failed.
+	if (table->gpa == NULL || table->toefl == NULL || table->status == NULL || table->name_offset == NULL ||
+		table->name_pool == NULL) {
+		puts("Memory allocation for student table failed :(\n");
+		exit(1);
+	}
+}
+
+//Function to allocate memory for the table columns and name pool.
+void table_init(StudentTable *table, int capacity) {
+	table_init_sized(table, capacity, NAME_POOL_SIZE);
+}
+
+//Function to allocate a table sized for input_bytes of input. Columns get room for a typical line length
+//(They double if lines are shorter), the name pool gets input_bytes (A name is never longer than its line).
+//Pages that are never written aren't really used, so the extra room only costs address space until
+//table_shrink_to_fit().
+void table_init_for_input(StudentTable *table, size_t input_bytes) {
+	size_t capacity      = input_bytes / BYTES_PER_STUDENT + 1;
+	size_t pool_capacity = input_bytes + 1;
+
+	if (capacity < MAX_STUDENT) {
+		capacity = MAX_STUDENT;
+	}
+	if (capacity > 0x7FFFFFFF) {
+		capacity = 0x7FFFFFFF;
+	}
+	if (pool_capacity < NAME_POOL_SIZE) {
+		pool_capacity = NAME_POOL_SIZE;
+	}
+	if (pool_capacity > 0xFFFFFFFFu) {
+		pool_capacity = 0xFFFFFFFFu;
+	}
+	table_init_sized(table, (int)capacity, pool_capacity);
+}
+
+//Function to make the columns and name pool exactly as big as what they hold.
+void table_shrink_to_fit(StudentTable *table) {
+	int capacity         = table->count > 0 ? table->count : 1;
+	size_t pool_capacity = table->pool_size > 0 ? table->pool_size : 1;
+
+	if (capacity < table->capacity) {
+		table->gpa         = realloc(table->gpa, capacity * sizeof(int));
+		table->toefl       = realloc(table->toefl, capacity * sizeof(int));
+		table->status      = realloc(table->status, capacity * sizeof(char));
+		table->name_offset = realloc(table->name_offset, capacity * sizeof(unsigned int));
+		table->capacity    = capacity;
+	}
+	if (pool_capacity < table->pool_capacity) {
+		table->name_pool     = realloc(table->name_pool, pool_capacity);
+		table->pool_capacity = pool_capacity;
+	}
+
+	//Throwing an error, if memory reallocation failed (Shrinking hardly ever fails).
+	if (table->gpa == NULL || table->toefl == NULL || table->status == NULL || table->name_offset == NULL ||
+		table->name_pool == NULL) {
+		puts("Memory reallocation failed :/ \n");
+		exit(1);
+	}
+}
+
+//Function to double the capacity of every column.
+static void grow_columns(StudentTable *table) {
+	table->capacity *= 2;
+	table->column_grows++;
+	table->gpa         = realloc(table->gpa, table->capacity * sizeof(int));
+	table->toefl       = realloc(table->toefl, table->capacity * sizeof(int));
+	table->status      = realloc(table->status, table->capacity * sizeof(char));
+	table->name_offset = realloc(table->name_offset, table->capacity * sizeof(unsigned int));
+
+	//Throwing an error, if memory reallocation failed.
+	if (table->gpa == NULL || table->toefl == NULL || table->status == NULL || table->name_offset == NULL) {
+		puts("Memory reallocation failed :/ \n");
+		exit(1);
+	}
+}
+
+//Function to make sure the table can hold count students and pool_bytes of names without growing.
+void table_reserve(StudentTable *table, int count, size_t pool_bytes) {
+	while (table->capacity < count) {
+		grow_columns(table);
+	}
+	if (table->pool_capacity < pool_bytes) {
+		table->pool_capacity = pool_bytes;
+		table->pool_grows++;
+		table->name_pool = realloc(table->name_pool, table->pool_capacity);
+
+		//Throwing an error, if memory reallocation failed.
+		if (table->name_pool == NULL || table->pool_capacity > 0xFFFFFFFFu) {
+			puts("Memory reallocation for name pool failed :/ \n");
+			exit(1);
+		}
+	}
+}
+
+//Function to add every student of source at the end of table, in order.
+void table_append_table(StudentTable *table, const StudentTable *source) {
+	table_reserve(table, table->count + source->count, table->pool_size + source->pool_size);
+
+	memcpy(table->gpa + table->count, source->gpa, source->count * sizeof(int));
+	memcpy(table->toefl + table->count, source->toefl, source->count * sizeof(int));
+	memcpy(table->status + table->count, source->status, source->count * sizeof(char));
+	memcpy(table->name_pool + table->pool_size, source->name_pool, source->pool_size);
+
+	//Names moved by pool_size bytes.
+	for (int i = 0; i < source->count; i++) {
+		table->name_offset[table->count + i] = source->name_offset[i] + (unsigned int)table->pool_size;
+	}
+	table->count     += source->count;
+	table->pool_size += source->pool_size;
+
+	for (int i = 0; i < NUM_OF_PARSE_RESULTS; i++) {
+		table->results[i] += source->results[i];
+	}
+	table->column_grows += source->column_grows;
+	table->pool_grows   += source->pool_grows;
+}
+
+//Function to allocate table as a copy of source (Gpa order too), with room for extra_bytes more of input.
+void table_copy(StudentTable *table, const StudentTable *source, size_t extra_bytes) {
+	size_t capacity = (size_t)source->count + extra_bytes / BYTES_PER_STUDENT + 1;
+
+	table_init_sized(table, capacity > MAX_STUDENT ? (int)capacity : MAX_STUDENT,
+		source->pool_size + extra_bytes + NAME_POOL_SIZE);
+	table_append_table(table, source);
+
+	if (source->gpa_order != NULL) {
+		table->gpa_order = table_allocate_indices(table);
+		memcpy(table->gpa_order, source->gpa_order, source->count * sizeof(unsigned int));
+	}
+}
+
+//Function to add one student at the end of the table. This is the only place a name is copied.
+void table_append(StudentTable *table, Slice first_name, Slice last_name, int gpa, char status, int toefl) {
+
+	if (table->count >= table->capacity) {
+		grow_columns(table);
+	}
+
+	// +2 --> 1 for space between fist name and last name. 1 for null terminator.
+	size_t name_length = first_name.length + last_name.length + 2;
+
+	//Doubling the name pool until the name fits. Offsets are unsigned int, so the pool stays under 4GB.
+	while (table->pool_size + name_length > table->pool_capacity) {
+		table->pool_capacity *= 2;
+		table->pool_grows++;
+		table->name_pool = realloc(table->name_pool, table->pool_capacity);
+
+		//Throwing an error, if memory reallocation failed.
+		if (table->name_pool == NULL || table->pool_capacity > 0xFFFFFFFFu) {
+			puts("Memory reallocation for name pool failed :/ \n");
+			exit(1);
+		}
+	}
+
+	//String concatenation for first and last name and make it as one name
+	char *name = table->name_pool + table->pool_size;
+	memcpy(name, first_name.start, first_name.length);
+	name[first_name.length] = ' ';
+	memcpy(name + first_name.length + 1, last_name.start, last_name.length);
+	name[name_length - 1] = '\0';
+
+	table->gpa[table->count]         = gpa;
+	table->toefl[table->count]       = toefl;
+	table->status[table->count]      = status;
+	table->name_offset[table->count] = (unsigned int)table->pool_size;
+	table->pool_size += name_length;
+	table->count++;
+}
+
+//Function to parse one line of input file in place into student (Fields stay slices of the line).
+//Doesn't print or exit, so it can run on any thread. Caller reports the result (PARSE_OK, ...).
+int parse_student(Slice line, ParsedStudent *student) {
+
+	//Splitting line into fields in place: first name, last name, GPA, student status, TOEFL.
+	Slice fields[MAX_FIELDS];
+	int num_of_fields = split_fields(line, fields, MAX_FIELDS);
+
+	//Checking if first name or last name or GPA or student status char are not empty.
+	if (num_of_fields < 4) {
+		return PARSE_MISSING_FIELD;
+	}
+
+	student->first_name = fields[0];
+	student->last_name  = fields[1];
+	student->status     = fields[3].start[0];
+	student->toefl      = 0;
+
+	//Converting gpa field to GPA_SCALE x thousandths. A gpa that can't be read counts as 0 (Invalid), like strtof().
+	if (!parse_gpa(fields[2], &student->gpa)) {
+		student->gpa = 0;
+	}
+
+	//Same rules as validate_domestic() and validate_international().
+	if (student->status == 'D') {
+		if (student->gpa <= 0) {
+			return PARSE_INVALID_GPA;
+		}
+	} else if (student->status == 'I') {
+
+		//Validating toefl score to make sure it's international students' data. Missing TOEFL counts as 0.
+		if (num_of_fields < 5 || !parse_toefl(fields[4], &student->toefl) || student->toefl <= 0) {
+			return PARSE_INVALID_TOEFL;
+		}
+		if (student->gpa <= 0) {
+			return PARSE_INVALID_GPA;
+		}
+	} else {
+		return PARSE_UNKNOWN_STATUS;
+	}
+	return PARSE_OK;
+}
+
+//Function to parse each line of input file and add it to the table if the student data is valid.
+int parse_line_into_table(Slice line, StudentTable *table) {
+	ParsedStudent student;
+	int result = parse_student(line, &student);
+
+	table->results[result]++;
+	if (result == PARSE_OK) {
+		table_append(table, student.first_name, student.last_name, student.gpa, student.status, student.toefl);
+	}
+	return result;
+}
+
+//Function to parse one line like parse_line_into_table(), but a line longer than MAX_LINE_LENGTH is rejected first.
+int parse_line_into_table_limited(Slice line, StudentTable *table) {
+	if (line.length > MAX_LINE_LENGTH) {
+		table->results[PARSE_LINE_TOO_LONG]++;
+		return PARSE_LINE_TOO_LONG;
+	}
+	return parse_line_into_table(line, table);
+}
+
+//Function to print the message for a parse result. Exits on a missing field, like parse_line_of_file().
+void report_parse_result(int result) {
+	if (result == PARSE_INVALID_TOEFL) {
+		printf("Invalid TOEFL score :/\n");
+	} else if (result == PARSE_MISSING_FIELD) {
+		puts("ERROR!!!!!! ERROR!!!!!! Where is name or GPA or student status char? :/\n");
+		exit(1);
+	}
+}
+
+//Function to get the name of a parse result.
+const char *parse_result_name(int result) {
+	static const char *names[NUM_OF_PARSE_RESULTS] = {"ok", "invalid_toefl", "missing_field", "invalid_gpa",
+		"unknown_status", "line_too_long"};
+
+	return result >= 0 && result < NUM_OF_PARSE_RESULTS ? names[result] : "unknown";
+}
+
+//Function to write one student. International students have TOEFL at the end if show_toefl is 1 (Options 1 ~ 3).
+void table_write_student(OutputWriter *writer, const StudentTable *table, int index, int show_toefl) {
+	writer_write_student(writer, table_name(table, index), table_name_length(table, index), table->gpa[index],
+		table->status[index], show_toefl ? table->toefl[index] : 0);
+}
+
+//Function to allocate room for the index of every student in the table.
+unsigned int *table_allocate_indices(const StudentTable *table) {
+	unsigned int *indices = malloc((table->count > 0 ? table->count : 1) * sizeof(unsigned int));
+
+	//Throwing an error, if memory allocation failed.
+	if (indices == NULL) {
+		puts("Memory allocation for student indices failed :(\n");
+		exit(1);
+	}
+	return indices;
+}
+
+//Function to find the next selected student with the given status, starting from position in indices.
+static int next_selected_with_status(const StudentTable *table, const unsigned int *indices, int num_of_selected,
+	int position, char status) {
+	while (position < num_of_selected && table->status[indices[position]] != status) {
+		position++;
+	}
+	return position;
+}
+
+//Function to put selected students in the order of all_student_with_good_GPA():
+//1st domestic, 1st international, 2nd domestic, ... where "1st" counts every student of that status.
+void table_interleave_indices(const StudentTable *table, unsigned int *indices, int num_of_selected) {
+	int *ranks            = malloc((num_of_selected > 0 ? num_of_selected : 1) * sizeof(int));
+	unsigned int *ordered = malloc((num_of_selected > 0 ? num_of_selected : 1) * sizeof(unsigned int));
+
+	//Throwing an error, if memory allocation failed.
+	if (ranks == NULL || ordered == NULL) {
+		puts("Memory allocation for student ranks failed :(\n");
+		exit(1);
+	}
+
+	//Rank of a student = number of students with the same status before it. Only the status column is read.
+	int domestic_count      = 0;
+	int international_count = 0;
+	int position            = 0;
+	for (int i = 0; i < table->count && position < num_of_selected; i++) {
+		if ((int)indices[position] == i) {
+			ranks[position++] = table->status[i] == 'D' ? domestic_count : international_count;
+		}
+		domestic_count      += table->status[i] == 'D';
+		international_count += table->status[i] == 'I';
+	}
+
+	//Merging selected domestic and international students by rank, domestic first on the same rank.
+	int domestic      = next_selected_with_status(table, indices, num_of_selected, 0, 'D');
+	int international = next_selected_with_status(table, indices, num_of_selected, 0, 'I');
+	int num_of_ordered = 0;
+	while (domestic < num_of_selected || international < num_of_selected) {
+		if (international >= num_of_selected || (domestic < num_of_selected &&
+			ranks[domestic] <= ranks[international])) {
+			ordered[num_of_ordered++] = indices[domestic];
+			domestic = next_selected_with_status(table, indices, num_of_selected, domestic + 1, 'D');
+		} else {
+			ordered[num_of_ordered++] = indices[international];
+			international = next_selected_with_status(table, indices, num_of_selected, international + 1, 'I');
+		}
+	}
+
+	memcpy(indices, ordered, num_of_ordered * sizeof(unsigned int));
+	free(ranks);
+	free(ordered);
+}
+
+//Function to sort student indices by gpa by using LSD radix sort (Stable).
+//Gpa column is already fixed-point (GPA_SCALE x thousandths), so it's the key as it is.
+static void radix_sort_indices_gpa(const int *gpa, unsigned int *indices, int count, int descending) {
+	if (count < 2) {
+		return;
+	}
+
+	unsigned int *keys = malloc(count * sizeof(unsigned int));
+
+	//Throwing an error, if memory allocation failed.
+	if (keys == NULL) {
+		puts("Memory allocation for sorting failed :(\n");
+		exit(1);
+	}
+
+	//Inverting gpa gives descending order (Valid gpa is never negative).
+	unsigned int high_bits = 0;
+	for (int i = 0; i < count; i++) {
+		keys[i]    = descending ? ~(unsigned int)gpa[indices[i]] : (unsigned int)gpa[indices[i]];
+		high_bits |= (unsigned int)gpa[indices[i]];
+	}
+
+	radix_sort_keys(keys, indices, count, high_bits);
+	free(keys);
+}
+
+//Function to sort selected students (indices in table order) by gpa. Sort is stable, and equal gpa keeps
+//domestic students first, then table order, like fprintf_sorted_gpa().
+void table_sort_indices_by_gpa(const StudentTable *table, unsigned int *indices, int num_of_selected,
+	int descending) {
+	unsigned int *temp = malloc((num_of_selected > 0 ? num_of_selected : 1) * sizeof(unsigned int));
+
+	//Throwing an error, if memory allocation failed.
+	if (temp == NULL) {
+		puts("Memory allocation for sorting failed :(\n");
+		exit(1);
+	}
+
+	//Domestic students first, then international students.
+	int num_of_ordered = 0;
+	for (int i = 0; i < num_of_selected; i++) {
+		if (table->status[indices[i]] == 'D') {
+			temp[num_of_ordered++] = indices[i];
+		}
+	}
+	for (int i = 0; i < num_of_selected; i++) {
+		if (table->status[indices[i]] != 'D') {
+			temp[num_of_ordered++] = indices[i];
+		}
+	}
+	memcpy(indices, temp, num_of_selected * sizeof(unsigned int));
+	free(temp);
+
+	radix_sort_indices_gpa(table->gpa, indices, num_of_selected, descending);
+}
+
+//Function to keep the best limit selected students (indices in table order) by gpa, in the same order as
+//table_sort_indices_by_gpa(). Only a heap of limit students is kept, the rest are never sorted.
+int table_top_indices_by_gpa(const StudentTable *table, unsigned int *indices, int num_of_selected, int limit,
+	int descending) {
+	TopK top;
+	topk_init(&top, limit);
+
+	for (int i = 0; i < num_of_selected; i++) {
+		unsigned int index     = indices[i];
+		unsigned long long key = topk_key(table->gpa[index], table->status[index], index, descending);
+
+		if (topk_accepts(&top, key)) {
+			topk_insert(&top, key, index);
+		}
+	}
+
+	int num_of_kept = topk_finish(&top, indices);
+	topk_free(&top);
+	return num_of_kept;
+}
+
+//Function to sort every student by gpa, highest first, into gpa_order.
+void table_build_gpa_order(StudentTable *table) {
+	free(table->gpa_order);
+	table->gpa_order = table_allocate_indices(table);
+
+	for (int i = 0; i < table->count; i++) {
+		table->gpa_order[i] = i;
+	}
+	table_sort_indices_by_gpa(table, table->gpa_order, table->count, 1);
+}
+
+//Function to merge students from first_new on into gpa_order. Old and new students are each sorted, so one
+//merge on (gpa, domestic first, table order) gives the same order as sorting everyone.
+void table_extend_gpa_order(StudentTable *table, int first_new) {
+	if (table->gpa_order == NULL) {
+		table_build_gpa_order(table);
+		return;
+	}
+
+	int num_of_new       = table->count - first_new;
+	unsigned int *added  = malloc((num_of_new > 0 ? num_of_new : 1) * sizeof(unsigned int));
+	unsigned int *merged = table_allocate_indices(table);
+
+	//Throwing an error, if memory allocation failed.
+	if (added == NULL) {
+		puts("Memory allocation for sorting failed :(\n");
+		exit(1);
+	}
+
+	for (int i = 0; i < num_of_new; i++) {
+		added[i] = first_new + i;
+	}
+	table_sort_indices_by_gpa(table, added, num_of_new, 1);
+
+	int old_position = 0;
+	int new_position = 0;
+	for (int i = 0; i < table->count; i++) {
+		int take_old = new_position >= num_of_new;
+
+		if (!take_old && old_position < first_new) {
+			unsigned int old_index = table->gpa_order[old_position];
+			unsigned int new_index = added[new_position];
+
+			take_old = topk_key(table->gpa[old_index], table->status[old_index], old_index, 1) <
+				topk_key(table->gpa[new_index], table->status[new_index], new_index, 1);
+		}
+		merged[i] = take_old ? table->gpa_order[old_position++] : added[new_position++];
+	}
+
+	free(added);
+	free(table->gpa_order);
+	table->gpa_order = merged;
+}
+
+//Function to free all memory of the table.
+void table_free(StudentTable *table) {
+	free(table->gpa_order);
+	free(table->gpa);
+	free(table->toefl);
+	free(table->status);
+	free(table->name_offset);
+	free(table->name_pool);
+}
@@ -0,0 +1,131 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: Has the columnar student table (struct of arrays) and its function prototypes.
+*          Domestic and international students live in one table, in input order.
+*          Each field is its own column, so a filter only reads the columns it needs.
+*          Names are stored one after another in a single string pool and found by offset.
+*/
+#ifndef TABLE_H //Checking if TABLE_H is not defined
+#define TABLE_H
+
+#include <stdio.h>
+#include "student.h"
+#include "input.h"
+#include "writer.h"
+
+#define NAME_POOL_SIZE (MAX_STUDENT * MAX_NAME_LENGTH) //First size of the name pool in bytes.
+#define BYTES_PER_STUDENT 24 //Rough size of one input line, for sizing a table from its input.
+
+#define PARSE_OK 0              //Valid student
+#define PARSE_INVALID_TOEFL 1   //International student with missing, unreadable or <= 0 TOEFL (Skipped)
+#define PARSE_MISSING_FIELD 2   //Name, GPA or student status is missing
+#define PARSE_INVALID_GPA 3     //Unreadable or <= 0 GPA (Skipped quietly, like validate_domestic())
+#define PARSE_UNKNOWN_STATUS 4  //Student status isn't 'D' or 'I' (Skipped quietly)
+#define PARSE_LINE_TOO_LONG 5   //Line is longer than MAX_LINE_LENGTH (Only checked with --rejects)
+#define NUM_OF_PARSE_RESULTS 6  //PARSE_OK ~ PARSE_LINE_TOO_LONG
+
+typedef struct {        //One parsed line (Names point into the line, nothing is copied)
+    Slice first_name;   //First name
+    Slice last_name;    //Last name
+    int gpa;            //GPA as GPA_SCALE x thousandths
+    char status;        //Student status ('D' or 'I')
+    int toefl;          //TOEFL (0 for domestic students)
+} ParsedStudent;
+
+
+typedef struct {    //Student table (Struct of arrays)
+    int *gpa;                   //GPA column as GPA_SCALE x thousandths (3.125 -> 12500, see parse_gpa())
+    int *toefl;                 //TOEFL column (0 for domestic students)
+    char *status;               //Student status column ('D' or 'I')
+    unsigned int *name_offset;  //Offset of each student's name in name_pool
+    char *name_pool;            //Every name ("first last\0"), one after another
+    int count;                  //Number of students in the table
+    int capacity;               //Number of students the columns can hold
+    size_t pool_size;           //Bytes used in name_pool
+    size_t pool_capacity;       //Bytes allocated for name_pool
+    unsigned int *gpa_order;    //Every student by gpa, highest first (NULL until table_build_gpa_order())
+    long results[NUM_OF_PARSE_RESULTS]; //Lines parsed into the table, by PARSE_ result (Counter)
+    int column_grows;           //Times the columns were reallocated (Counter)
+    int pool_grows;             //Times the name pool was reallocated (Counter)
+} StudentTable;
+
+//Function to get a student's name from the table
+static inline const char *table_name(const StudentTable *table, int index) {
+    return table->name_pool + table->name_offset[index];
+}
+
+//Function to get the length of a student's name (Names are stored in table order, so it ends before the next one)
+static inline size_t table_name_length(const StudentTable *table, int index) {
+    size_t next_offset = index + 1 < table->count ? table->name_offset[index + 1] : table->pool_size;
+    return next_offset - table->name_offset[index] - 1;
+}
+
+//Allocate memory for the table columns and name pool
+void table_init(StudentTable *table, int capacity);
+
+//Allocate a table sized for input_bytes of input, so it (Almost) never grows while it's filled
+//Names are never longer than their lines, so the name pool never grows. Call table_shrink_to_fit() once it's full.
+void table_init_for_input(StudentTable *table, size_t input_bytes);
+
+//Make the columns and name pool exactly as big as what they hold (Once, after the table is filled)
+void table_shrink_to_fit(StudentTable *table);
+
+//Make sure the table can hold count students and pool_bytes of names without growing
+void table_reserve(StudentTable *table, int count, size_t pool_bytes);
+
+//Allocate table as a copy of source (Gpa order too), with room for extra_bytes more of input
+void table_copy(StudentTable *table, const StudentTable *source, size_t extra_bytes);
+
+//Add every student of source at the end of table, in order (Counters are added too)
+void table_append_table(StudentTable *table, const StudentTable *source);
+
+//Add one student at the end of the table (Columns and name pool grow when full)
+void table_append(StudentTable *table, Slice first_name, Slice last_name, int gpa, char status, int toefl);
+
+//Parsing one line of input file in place into student (Only fields read so far are set if it's not PARSE_OK)
+int parse_student(Slice line, ParsedStudent *student);
+
+//Parsing one line of input file in place and adding it to the table if the student data is valid
+//Returns one of the PARSE_ results
+int parse_line_into_table(Slice line, StudentTable *table);
+
+//Same as parse_line_into_table(), but a line longer than MAX_LINE_LENGTH is PARSE_LINE_TOO_LONG without parsing
+int parse_line_into_table_limited(Slice line, StudentTable *table);
+
+//Printing the message for a parse result (Exits on PARSE_MISSING_FIELD)
+void report_parse_result(int result);
+
+//Function to get the name of a parse result ("ok", "invalid_toefl", ...)
+const char *parse_result_name(int result);
+
+//Function to write one student (International students have TOEFL at the end if show_toefl is 1)
+void table_write_student(OutputWriter *writer, const StudentTable *table, int index, int show_toefl);
+
+//Function to allocate room for the index of every student in the table
+unsigned int *table_allocate_indices(const StudentTable *table);
+
+//Function to put selected students (indices in table order) as 1st domestic, 1st international, 2nd domestic, ...
+//Same order as all_student_with_good_GPA() (Option 3).
+void table_interleave_indices(const StudentTable *table, unsigned int *indices, int num_of_selected);
+
+//Function to sort selected students (indices in table order) by gpa (Stable, domestic first on equal gpa)
+void table_sort_indices_by_gpa(const StudentTable *table, unsigned int *indices, int num_of_selected,
+    int descending);
+
+//Function to keep the best limit selected students (indices in table order) by gpa, best first
+//Same order as table_sort_indices_by_gpa(), without sorting everyone. Returns how many are kept.
+int table_top_indices_by_gpa(const StudentTable *table, unsigned int *indices, int num_of_selected, int limit,
+    int descending);
+
+//Function to sort every student by gpa, highest first, into gpa_order (Same order as option 4)
+void table_build_gpa_order(StudentTable *table);
+
+//Function to add students from first_new on (Appended after gpa_order was built) into gpa_order
+//Only the new students are sorted, then merged with the old order. Same result as table_build_gpa_order().
+void table_extend_gpa_order(StudentTable *table, int first_new);
+
+//Freeing all memory of the table
+void table_free(StudentTable *table);
+
+#endif // Ending #ifndef block
@@ -0,0 +1,101 @@
+"""
+Author: Yujin Jeong
+Date: 17th Oct 2024
+Purpose: Checks that --snapshot --append-only gives the same run as parsing the whole input again.
+         A roster is appended in random-sized batches, cut anywhere (Also in the middle of a line).
+         After each batch, options 1, 3, 4 and an ascending limit query run with -j 1 and -j 4, once on the
+         whole input and once with the append-only snapshot. Exit code, printed messages and output must match.
+         Usage: append_only_snapshot.py <Lab6 executable> [seed] [batches]
+"""
+
+import os
+import random
+import subprocess
+import sys
+import tempfile
+
+QUERIES = ["1", "3", "4", "gpa>=3 order by gpa asc limit 25"]
+THREADS = [1, 4]
+ROSTER_LINES = 24000  # About 550 KB, so -j 4 gets four chunks of at least 64 KB.
+FIRST_NAMES = ["Mary", "Jack", "Mike", "Jane", "John", "Ava", "Mia", "Noah", "Liam", "Emma", "Olivia", "Lucas"]
+LAST_NAMES = ["Jackson", "He", "Johnson", "Zhang", "Den", "Miller", "Thomas", "Brown", "Smith", "Wilson"]
+
+
+# Function to make one roster line. Some have TOEFL <= 0, so "Invalid TOEFL score" is printed too.
+def roster_line(rng):
+    name = f"{rng.choice(FIRST_NAMES)} {rng.choice(LAST_NAMES)}"
+    gpa = f"{rng.randint(100, 4300) / 1000:.{rng.randint(1, 3)}f}"
+    if rng.random() < 0.5:
+        return f"{name} {gpa} D\n"
+    toefl = rng.choice([rng.randint(60, 120), rng.randint(60, 120), rng.randint(60, 120), 0])
+    return f"{name} {gpa} I {toefl}\n"
+
+
+# Function to run Lab6 and get its exit code, printed messages and output file.
+def run_lab6(lab6, arguments, output_file):
+    if os.path.exists(output_file):
+        os.remove(output_file)
+    result = subprocess.run([lab6] + arguments, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    output = b""
+    if os.path.exists(output_file):
+        with open(output_file, "rb") as file:
+            output = file.read()
+    return result.returncode, result.stdout, output
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("Usage: append_only_snapshot.py <Lab6 executable> [seed] [batches]")
+        return 1
+
+    lab6 = os.path.abspath(sys.argv[1])
+    seed = int(sys.argv[2]) if len(sys.argv) > 2 else 6
+    batches = int(sys.argv[3]) if len(sys.argv) > 3 else 12
+    rng = random.Random(seed)
+    roster = "".join(roster_line(rng) for _ in range(ROSTER_LINES)).encode()
+
+    # Cutting the roster at random bytes. Half the cuts are moved to the next line, so there are runs that end
+    # in the middle of a line (Left out of the snapshot) and runs that finish with every output written.
+    cuts = sorted(rng.sample(range(1, len(roster)), batches - 1))
+    cuts = sorted(set(roster.index(b"\n", cut) + 1 if rng.random() < 0.5 else cut for cut in cuts))
+    cuts.append(len(roster))
+    failures = 0
+    finished = 0
+
+    with tempfile.TemporaryDirectory() as directory:
+        input_file = os.path.join(directory, "roster.txt")
+        fresh_file = os.path.join(directory, "fresh.txt")
+        snapshot_output_file = os.path.join(directory, "snapshot.txt")
+        open(input_file, "wb").close()
+
+        previous = 0
+        for batch, cut in enumerate(cuts):
+            with open(input_file, "ab") as file:
+                file.write(roster[previous:cut])
+            previous = cut
+
+            for threads in THREADS:
+                snapshot_file = os.path.join(directory, f"roster_j{threads}.snap")
+
+                for query in QUERIES:
+                    common = ["-j", str(threads)]
+                    fresh = run_lab6(lab6, [input_file, fresh_file, query] + common, fresh_file)
+                    from_snapshot = run_lab6(lab6, [input_file, snapshot_output_file, query] + common +
+                                             ["--snapshot", snapshot_file, "--append-only"], snapshot_output_file)
+
+                    finished += fresh[0] == 0
+                    if fresh != from_snapshot:
+                        failures += 1
+                        print(f"batch {batch} ({cut} bytes), -j {threads}, query \"{query}\": "
+                              f"exit {fresh[0]} vs {from_snapshot[0]}, "
+                              f"{len(fresh[1])} vs {len(from_snapshot[1])} message bytes, "
+                              f"{len(fresh[2])} vs {len(from_snapshot[2])} output bytes")
+
+    runs = len(cuts) * len(THREADS) * len(QUERIES)
+    print(f"{runs - failures} of {runs} append-only snapshot runs match the full parse "
+          f"({finished} ran to the end, seed {seed})")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,87 @@
+"""
+Author: Yujin Jeong
+Date: 17th Oct 2024
+Purpose: Checks gpa with more than three decimal places against what the original strtof() version of Lab6 wrote.
+         "3.9004" is over 3.9, so options 1 ~ 3 keep it, while it's still written as 3.900. "3.9995" is written
+         as 4.000 but sorted under 4.0004. Runs with and without --stream and with a snapshot.
+         Usage: gpa_decimals.py <Lab6 executable>
+"""
+
+import os
+import subprocess
+import sys
+import tempfile
+
+ROSTER = b"""Ava Low 3.8996 D
+Ben Exact 3.9 D
+Cal Above 3.9004 D
+Eve Tiny 3.90001 I 90
+Fay Round 3.9995 I 80
+Gus Half 3.9005 D
+Hal Over 4.0004 D
+Ivy Small 0.0001 D
+Kim Plain 3.950 I 70
+Len Below 3.8994 I 75
+"""
+
+# Output files of the original Lab6 (strtof() and "%.3f") for this roster.
+EXPECTED = {
+    "1": b"Cal Above 3.900 D\nGus Half 3.901 D\nHal Over 4.000 D\n",
+    "2": b"Eve Tiny 3.900 I 90\nFay Round 4.000 I 80\nKim Plain 3.950 I 70\n",
+    "3": b"Eve Tiny 3.900 I 90\nFay Round 4.000 I 80\nCal Above 3.900 D\nKim Plain 3.950 I 70\nGus Half 3.901 D\n"
+         b"Hal Over 4.000 D\n",
+    "4": b"Hal Over 4.000 D\nFay Round 4.000 I\nKim Plain 3.950 I\nGus Half 3.901 D\nCal Above 3.900 D\n"
+         b"Eve Tiny 3.900 I\nBen Exact 3.900 D\nAva Low 3.900 D\nLen Below 3.899 I\nIvy Small 0.000 D\n",
+    "gpa<=3.9 and gpa>=3.8995": b"Ava Low 3.900 D\nBen Exact 3.900 D\n",
+    "gpa=3.9": b"Ben Exact 3.900 D\n",
+}
+STREAMED = ["1", "2", "gpa<=3.9 and gpa>=3.8995", "gpa=3.9"]  # --stream writes option 3 in input order (See stream.h).
+
+
+# Function to run Lab6 and get its exit code and output file.
+def run_lab6(lab6, arguments, output_file):
+    if os.path.exists(output_file):
+        os.remove(output_file)
+    result = subprocess.run([lab6] + arguments, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    output = b""
+    if os.path.exists(output_file):
+        with open(output_file, "rb") as file:
+            output = file.read()
+    return result.returncode, output
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("Usage: gpa_decimals.py <Lab6 executable>")
+        return 1
+
+    lab6 = os.path.abspath(sys.argv[1])
+    failures = 0
+    runs = 0
+
+    with tempfile.TemporaryDirectory() as directory:
+        input_file = os.path.join(directory, "roster.txt")
+        output_file = os.path.join(directory, "output.txt")
+        snapshot_file = os.path.join(directory, "roster.snap")
+        with open(input_file, "wb") as file:
+            file.write(ROSTER)
+
+        for query, expected in EXPECTED.items():
+            modes = [[], ["--snapshot", snapshot_file], ["--snapshot", snapshot_file]]
+            if query in STREAMED:
+                modes.append(["--stream"])
+
+            for mode in modes:
+                runs += 1
+                result = run_lab6(lab6, [input_file, output_file, query] + mode, output_file)
+                if result != (0, expected):
+                    failures += 1
+                    print(f"query \"{query}\" {' '.join(mode)}: exit {result[0]}, wrote {result[1]!r}, "
+                          f"expected {expected!r}")
+
+    print(f"{runs - failures} of {runs} runs write what strtof() and \"%.3f\" wrote")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
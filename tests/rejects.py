@@ -0,0 +1,103 @@
+"""
+Author: Yujin Jeong
+Date: 17th Oct 2024
+Purpose: Checks that --rejects stops (Or doesn't stop) a run the same way with -j 1, -j 4 and --stream.
+         Each roster has its bad lines in a different part of the input, so a thread that only looked at its own
+         part would decide differently from one reading the whole input. Exit code, printed messages and the
+         reject file must match.
+         A short roster with one bad line has to run to the end and write the same output as a run without --rejects.
+         Usage: rejects.py <Lab6 executable> [seed]
+"""
+
+import os
+import random
+import subprocess
+import sys
+import tempfile
+
+MODES = [["-j", "1"], ["-j", "4"], ["--stream"]]
+ROSTER_LINES = 400000  # About 8 MB, so -j 4 gets four chunks.
+SHORT_ROSTER = b"".join(f"Good{i} Student 3.9{i}5 D\n".encode() for i in range(8)) + b"Bad Line 3.5 I 0\n"
+
+
+# Function to make a roster where lines in [bad_start, bad_end) are bad with bad_share, and the rest with 1%.
+def roster(rng, bad_start, bad_end, bad_share):
+    lines = []
+    for i in range(ROSTER_LINES):
+        share = bad_share if bad_start <= i < bad_end else 0.01
+        if rng.random() < share:
+            lines.append(rng.choice(["Bad Line 3.5 I 0", "Bad Line", "Bad Line 3.5 X"]))
+        else:
+            lines.append(f"Good{i} Student {rng.randint(100, 4000) / 1000:.3f} D")
+    return ("\n".join(lines) + "\n").encode()
+
+
+# Function to run Lab6 (With --rejects unless it's None) and get its exit code, printed messages and reject file.
+def run_lab6(lab6, input_file, directory, mode, reject_file):
+    for file_name in [reject_file, os.path.join(directory, "output.txt")]:
+        if file_name is not None and os.path.exists(file_name):
+            os.remove(file_name)
+    rejects = ["--rejects", reject_file] if reject_file is not None else []
+    result = subprocess.run([lab6, input_file, os.path.join(directory, "output.txt"), "3"] + rejects + mode,
+                            stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    if reject_file is None:
+        return result.returncode, result.stdout, b""
+    with open(reject_file, "rb") as file:
+        return result.returncode, result.stdout, file.read()
+
+
+# Function to read the output file of the last run.
+def read_output(directory):
+    with open(os.path.join(directory, "output.txt"), "rb") as file:
+        return file.read()
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("Usage: rejects.py <Lab6 executable> [seed]")
+        return 1
+
+    lab6 = os.path.abspath(sys.argv[1])
+    seed = int(sys.argv[2]) if len(sys.argv) > 2 else 21
+    rng = random.Random(seed)
+    cases = {
+        "5% bad in the last quarter": roster(rng, 300000, 400000, 0.20),
+        "30% bad in the second quarter": roster(rng, 100000, 200000, 0.30),
+        "30% bad at the start": roster(rng, 0, 5000, 0.30),
+    }
+    failures = 0
+
+    with tempfile.TemporaryDirectory() as directory:
+        input_file = os.path.join(directory, "roster.txt")
+        reject_file = os.path.join(directory, "rejects.txt")
+
+        for name, data in cases.items():
+            with open(input_file, "wb") as file:
+                file.write(data)
+
+            runs = [run_lab6(lab6, input_file, directory, mode, reject_file) for mode in MODES]
+            for mode, run in zip(MODES[1:], runs[1:]):
+                if run != runs[0]:
+                    failures += 1
+                    print(f"{name}, {' '.join(mode)}: exit {run[0]} vs {runs[0][0]}, {run[1]!r} vs {runs[0][1]!r}, "
+                          f"{len(run[2])} vs {len(runs[0][2])} reject file bytes")
+
+        # One bad line out of nine is over the rate, but too few to stop a short input.
+        with open(input_file, "wb") as file:
+            file.write(SHORT_ROSTER)
+        run_lab6(lab6, input_file, directory, [], None)
+        expected = read_output(directory)
+        for mode in MODES:
+            run = run_lab6(lab6, input_file, directory, mode, reject_file)
+            if run != (0, b"", b"9 invalid_toefl\n") or read_output(directory) != expected or not expected:
+                failures += 1
+                print(f"short roster, {' '.join(mode)}: exit {run[0]}, {run[1]!r}, reject file {run[2]!r}, "
+                      f"{len(read_output(directory))} vs {len(expected)} output bytes")
+
+    runs = len(cases) * (len(MODES) - 1) + len(MODES)
+    print(f"{runs - failures} of {runs} --rejects runs pass (seed {seed})")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
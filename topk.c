@@ -0,0 +1,108 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: topk.c has implemented functions for the top N bounded heap.
+*		   topk_init() Allocating a heap for the best N students.
+*		   topk_insert() Keeping a student and pushing out the worst one when full.
+*		   topk_finish() Writing the kept students best first.
+*		   topk_free() Freeing the heap.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "topk.h"
+
+//Function to move the entry at position down until both children have smaller keys.
+static void sift_down(TopKEntry *entries, int count, int position) {
+	TopKEntry entry = entries[position];
+
+	while (2 * position + 1 < count) {
+		int child = 2 * position + 1;
+		if (child + 1 < count && entries[child + 1].key > entries[child].key) {
+			child++;
+		}
+		if (entries[child].key <= entry.key) {
+			break;
+		}
+		entries[position] = entries[child];
+		position = child;
+	}
+	entries[position] = entry;
+}
+
+//Function to move the entry at position up until its parent has a bigger key.
+static void sift_up(TopKEntry *entries, int position) {
+	TopKEntry entry = entries[position];
+
+	while (position > 0 && entries[(position - 1) / 2].key < entry.key) {
+		entries[position] = entries[(position - 1) / 2];
+		position = (position - 1) / 2;
+	}
+	entries[position] = entry;
+}
+
+//Function to allocate a heap for the best capacity students.
+void topk_init(TopK *topk, int capacity) {
+	topk->allocated = capacity < TOPK_FIRST_ALLOCATION ? (capacity > 0 ? capacity : 1) : TOPK_FIRST_ALLOCATION;
+	topk->entries   = malloc(topk->allocated * sizeof(TopKEntry));
+	topk->count     = 0;
+	topk->capacity  = capacity;
+
+	//Throwing an error, if memory allocation failed.
+	if (topk->entries == NULL) {
+		puts("Memory allocation for top students failed :(\n");
+		exit(1);
+	}
+}
+
+//Function to get the index the next topk_insert() pushes out.
+unsigned int topk_next_evicted(const TopK *topk) {
+	return topk->count < topk->capacity ? TOPK_NONE : topk->entries[0].index;
+}
+
+//Function to keep a student. The worst kept student is pushed out when the heap is full.
+unsigned int topk_insert(TopK *topk, unsigned long long key, unsigned int index) {
+	if (topk->count < topk->capacity) {
+
+		//Doubling the entries when they are full (Never past capacity).
+		if (topk->count == topk->allocated) {
+			int allocated = topk->allocated > topk->capacity / 2 ? topk->capacity : topk->allocated * 2;
+			TopKEntry *entries = realloc(topk->entries, allocated * sizeof(TopKEntry));
+
+			//Throwing an error, if memory reallocation failed.
+			if (entries == NULL) {
+				puts("Memory reallocation for top students failed :/\n");
+				exit(1);
+			}
+			topk->entries   = entries;
+			topk->allocated = allocated;
+		}
+		topk->entries[topk->count] = (TopKEntry){key, index};
+		sift_up(topk->entries, topk->count++);
+		return TOPK_NONE;
+	}
+
+	unsigned int evicted = topk->entries[0].index;
+	topk->entries[0] = (TopKEntry){key, index};
+	sift_down(topk->entries, topk->count, 0);
+	return evicted;
+}
+
+//Function to write the kept indices best first (Heap sort: the worst goes to the back each time).
+int topk_finish(TopK *topk, unsigned int *indices) {
+	int num_of_kept = topk->count;
+
+	for (int last = num_of_kept - 1; last >= 0; last--) {
+		indices[last] = topk->entries[0].index;
+		topk->entries[0] = topk->entries[last];
+		sift_down(topk->entries, last, 0);
+	}
+	topk->count = 0;
+	return num_of_kept;
+}
+
+//Function to free the heap.
+void topk_free(TopK *topk) {
+	free(topk->entries);
+	topk->entries = NULL;
+}
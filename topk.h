@@ -0,0 +1,56 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: Has the bounded heap for top N by gpa (--top N, or "order by gpa ... limit N") and its function prototypes.
+*          Only the best N students are kept while the others go past, so it takes O(n log N) time and O(N) memory
+*          instead of sorting everyone. Students come out in the same order as the full sort, ties included.
+*/
+#ifndef TOPK_H //Checking if TOPK_H is not defined
+#define TOPK_H
+
+#include <limits.h>
+
+#define TOPK_NONE UINT_MAX //No student was pushed out of the heap.
+#define TOPK_FIRST_ALLOCATION 1024 //Entries allocated at first. Doubled as students are kept, up to capacity.
+
+typedef struct {                //One kept student
+    unsigned long long key;     //Sort key (Smaller comes first)
+    unsigned int index;         //Table index, or slot of the student for the caller
+} TopKEntry;
+
+typedef struct {            //Bounded heap (Worst kept student on top)
+    TopKEntry *entries;     //Kept students
+    int count;              //Number of kept students
+    int capacity;           //Most students kept (N)
+    int allocated;          //Entries allocated (A big N only takes memory for the students actually kept)
+} TopK;
+
+//Function to make the sort key of a student: gpa first, then domestic before international, then input order.
+//Same order as table_sort_indices_by_gpa(). Valid gpa is never negative, so it fits in 31 bits.
+static inline unsigned long long topk_key(int gpa, char status, unsigned int sequence, int descending) {
+    unsigned long long gpa_key = descending ? (unsigned int)(INT_MAX - gpa) : (unsigned int)gpa;
+
+    return gpa_key << 33 | (unsigned long long)(status != 'D') << 32 | sequence;
+}
+
+//Function to check if a student with this key would be kept
+static inline int topk_accepts(const TopK *topk, unsigned long long key) {
+    return topk->count < topk->capacity || (topk->capacity > 0 && key < topk->entries[0].key);
+}
+
+//Function to allocate a heap for the best capacity students
+void topk_init(TopK *topk, int capacity);
+
+//Function to get the index the next topk_insert() pushes out (TOPK_NONE if the heap isn't full yet)
+unsigned int topk_next_evicted(const TopK *topk);
+
+//Function to keep a student (Check topk_accepts() first). Returns the index pushed out, or TOPK_NONE.
+unsigned int topk_insert(TopK *topk, unsigned long long key, unsigned int index);
+
+//Function to write the kept indices best first and empty the heap. Returns how many.
+int topk_finish(TopK *topk, unsigned int *indices);
+
+//Function to free the heap
+void topk_free(TopK *topk);
+
+#endif // Ending #ifndef block
@@ -0,0 +1,154 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: writer.c has implemented functions for the buffered output writer.
+*		   writer_open() Setting up the writer and its buffer.
+*		   writer_open_fd() Setting up the writer for a socket (Failed writes don't exit).
+*		   writer_write() Adding text as it is.
+*		   writer_write_student() Formatting one student into the buffer.
+*		   writer_flush() Writing the buffer to the file.
+*		   writer_close() Flushing and freeing the buffer.
+*/
+
+#define _POSIX_C_SOURCE 200809L //For fileno()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include "writer.h"
+#include "input.h"
+
+//Function to set up the writer for an opened file.
+void writer_open(OutputWriter *writer, FILE *file, size_t buffer_size) {
+	writer_open_fd(writer, fileno(file), buffer_size);
+	writer->exit_on_error = 1;
+}
+
+//Function to set up the writer for a socket (A write that fails only marks the writer as failed).
+void writer_open_fd(OutputWriter *writer, int fd, size_t buffer_size) {
+	if (buffer_size < WRITER_MIN_BUFFER_SIZE) {
+		buffer_size = WRITER_MIN_BUFFER_SIZE;
+	}
+
+	writer->fd       = fd;
+	writer->buffer   = malloc(buffer_size);
+	writer->size     = 0;
+	writer->capacity = buffer_size;
+	writer->bytes_written = 0;
+	writer->exit_on_error = 0;
+	writer->failed   = 0;
+
+	//Throwing an error, if memory allocation failed.
+	if (writer->buffer == NULL) {
+		puts("Memory allocation for output buffer failed :(\n");
+		exit(1);
+	}
+}
+
+//Function to write bytes to the file, calling write() again if only part of them went out.
+//Once a write has failed on a socket writer, everything after it is dropped.
+static void write_all(OutputWriter *writer, const char *bytes, size_t length) {
+	while (length > 0 && !writer->failed) {
+		ssize_t bytes_written = write(writer->fd, bytes, length);
+
+		if (bytes_written < 0 && errno == EINTR) {
+			continue;
+		}
+
+		//Throwing an error, if writing failed (A socket's client may just have left, so it only fails the writer).
+		if (bytes_written < 0) {
+			if (writer->exit_on_error) {
+				puts("Writing output file failed :/\n");
+				exit(1);
+			}
+			writer->failed = 1;
+			return;
+		}
+		bytes  += bytes_written;
+		length -= bytes_written;
+	}
+}
+
+//Function to write everything in the buffer to the file.
+void writer_flush(OutputWriter *writer) {
+	write_all(writer, writer->buffer, writer->size);
+	writer->bytes_written += writer->size;
+	writer->size = 0;
+}
+
+//Function to add text as it is.
+void writer_write(OutputWriter *writer, const char *text, size_t length) {
+	if (writer->capacity - writer->size < length) {
+		writer_flush(writer);
+
+		//Text bigger than the whole buffer goes straight to the file.
+		if (length > writer->capacity) {
+			write_all(writer, text, length);
+			writer->bytes_written += length;
+			return;
+		}
+	}
+	memcpy(writer->buffer + writer->size, text, length);
+	writer->size += length;
+}
+
+//Function to write a non-negative number in decimal at position. Returns the position after the last digit.
+static char *put_number(char *position, unsigned int number) {
+	char digits[10];
+	int num_of_digits = 0;
+
+	do {
+		digits[num_of_digits++] = (char)('0' + number % 10);
+		number /= 10;
+	} while (number > 0);
+
+	while (num_of_digits > 0) {
+		*position++ = digits[--num_of_digits];
+	}
+	return position;
+}
+
+//Function to add "<name> <gpa> <status>\n", with " <toefl>" before '\n' if toefl isn't 0.
+void writer_write_student(OutputWriter *writer, const char *name, size_t name_length, int gpa, char status,
+	int toefl) {
+
+	writer_write(writer, name, name_length);
+
+	//Numbers take at most WRITER_MIN_BUFFER_SIZE bytes, so flushing once makes room.
+	if (writer->capacity - writer->size < WRITER_MIN_BUFFER_SIZE) {
+		writer_flush(writer);
+	}
+
+	char *position = writer->buffer + writer->size;
+	*position++ = ' ';
+
+	//Gpa is written as whole part, '.', then exactly three digits of thousandths (Same as "%.3f").
+	int thousandths = gpa_to_thousandths(gpa);
+	position = put_number(position, (unsigned int)thousandths / 1000);
+	*position++ = '.';
+	*position++ = (char)('0' + thousandths / 100 % 10);
+	*position++ = (char)('0' + thousandths / 10 % 10);
+	*position++ = (char)('0' + thousandths % 10);
+
+	*position++ = ' ';
+	*position++ = status;
+
+	if (toefl != 0) {
+		*position++ = ' ';
+		if (toefl < 0) {
+			*position++ = '-';
+		}
+		position = put_number(position, toefl < 0 ? 0u - (unsigned int)toefl : (unsigned int)toefl);
+	}
+	*position++ = '\n';
+	writer->size = position - writer->buffer;
+}
+
+//Function to flush and free the buffer.
+void writer_close(OutputWriter *writer) {
+	writer_flush(writer);
+	free(writer->buffer);
+	writer->buffer = NULL;
+}
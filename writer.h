@@ -0,0 +1,48 @@
+/**
+* Author: Yujin Jeong
+* Date: 17th Oct 2024
+* Purpose: Has the buffered output writer and its function prototypes.
+*          Students are formatted straight into a big buffer (No format string, gpa written from fixed point)
+*          and the buffer goes out with one write() call when it's full. Output is the same as
+*          fprintf(file2, "%s %.3f %c %d\n", ...).
+*/
+#ifndef WRITER_H //Checking if WRITER_H is not defined
+#define WRITER_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#define WRITER_BUFFER_SIZE (1024 * 1024) //Default size of the output buffer in bytes (--out-buffer).
+#define WRITER_MIN_BUFFER_SIZE 64 //Smallest output buffer, big enough for gpa, status and TOEFL of one student.
+
+typedef struct {            //Output writer
+    int fd;                 //File descriptor of the output file
+    char *buffer;           //Formatted output not written yet
+    size_t size;            //Bytes in buffer
+    size_t capacity;        //Bytes allocated for buffer
+    size_t bytes_written;   //Bytes written to the file so far (Counter)
+    int exit_on_error;      //1 to exit if a write fails (Files), 0 to mark the writer as failed (Sockets)
+    int failed;             //1 once a write has failed (Output after it is dropped)
+} OutputWriter;
+
+//Function to set up the writer for an opened file (buffer_size is raised to WRITER_MIN_BUFFER_SIZE if smaller)
+void writer_open(OutputWriter *writer, FILE *file, size_t buffer_size);
+
+//Function to set up the writer for a socket. If a write fails (Client left), failed is set instead of exiting.
+void writer_open_fd(OutputWriter *writer, int fd, size_t buffer_size);
+
+//Function to add text as it is
+void writer_write(OutputWriter *writer, const char *text, size_t length);
+
+//Function to add "<name> <gpa> <status>\n", with " <toefl>" before '\n' if toefl isn't 0
+//Gpa is GPA_SCALE x thousandths, like the table, and is written with three decimal places.
+void writer_write_student(OutputWriter *writer, const char *name, size_t name_length, int gpa, char status,
+    int toefl);
+
+//Function to write everything in the buffer to the file
+void writer_flush(OutputWriter *writer);
+
+//Function to flush and free the buffer (Doesn't close the file)
+void writer_close(OutputWriter *writer);
+
+#endif // Ending #ifndef block